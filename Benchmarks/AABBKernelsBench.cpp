@@ -0,0 +1,138 @@
+/* Benchmark dos kernels de AABB
+ * Compara calculateAABB + checkCollision(Sprite, Sprite) por valor, como no jogo original,
+ * com os kernels em lote (escalar e SIMD) sobre colunas SoA. Confere que todos os
+ * caminhos encontram os mesmos itens.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glm/glm.hpp>
+#include "AABBKernels.h"
+#include "BenchUtil.h"
+
+using namespace glm;
+
+struct Sprite
+{
+	float VAO, textureID;
+	vec3 pos, dimensions;
+	float angle;
+	int nAnimations, nFrames, iAnimation, iFrame;
+	float ds, dt;
+	float vel;
+	vec2 PMax, PMin;
+	int effect;
+};
+
+static void calculateAABB(Sprite &sprite)
+{
+	sprite.PMin.x = sprite.pos.x - sprite.dimensions.x / 2.0;
+	sprite.PMin.y = sprite.pos.y - sprite.dimensions.y / 2.0;
+	sprite.PMax.x = sprite.pos.x + sprite.dimensions.x / 2.0;
+	sprite.PMax.y = sprite.pos.y + sprite.dimensions.y / 2.0;
+}
+
+// Cópia fiel da original, inclusive a passagem por valor
+static bool checkCollision(Sprite one, Sprite two)
+{
+	bool collisionX = (one.PMax.x >= two.PMin.x) && (two.PMax.x >= one.PMin.x);
+	bool collisionY = (one.PMax.y >= two.PMin.y) && (two.PMax.y >= one.PMin.y);
+	return collisionX && collisionY;
+}
+
+int main()
+{
+	const uint32_t n = 100000;
+	const int frames = 200;
+	printf("caminho SIMD compilado: %s, %u itens, %d frames\n\n", aabbKernelPath(), n, frames);
+
+	std::vector<Sprite> sprites(n);
+	std::vector<float> posX(n), posY(n), halfW(n), halfH(n), minX(n), minY(n), maxX(n), maxY(n);
+	srand(3);
+	for (uint32_t i = 0; i < n; i++)
+	{
+		posX[i] = (float)(rand() % 8000) * 0.1f;
+		posY[i] = (float)(rand() % 6000) * 0.1f;
+		halfW[i] = halfH[i] = 8.0f + (rand() % 16);
+		sprites[i].pos = vec3(posX[i], posY[i], 0);
+		sprites[i].dimensions = vec3(halfW[i] * 2, halfH[i] * 2, 1);
+	}
+	Sprite character = {};
+	character.pos = vec3(400, 100, 0);
+	character.dimensions = vec3(48, 64, 1);
+	calculateAABB(character);
+	AABB box = { character.PMin.x, character.PMin.y, character.PMax.x, character.PMax.y };
+	AABBColumns columns = { minX.data(), minY.data(), maxX.data(), maxY.data() };
+
+	std::vector<uint32_t> hitsRef(n), hitsScalar(n), hitsSimd(n);
+	std::vector<uint64_t> mask((n + 63) / 64);
+	uint32_t nRef = 0, nScalar = 0, nSimd = 0, nMask = 0;
+
+	double refMs = bestOf(3, [&]() {
+		for (int f = 0; f < frames; f++)
+		{
+			nRef = 0;
+			for (uint32_t i = 0; i < n; i++)
+			{
+				calculateAABB(sprites[i]);
+				if (checkCollision(character, sprites[i]))
+				{
+					hitsRef[nRef++] = i;
+				}
+			}
+		}
+		doNotOptimize(nRef);
+	});
+
+	double scalarMs = bestOf(3, [&]() {
+		for (int f = 0; f < frames; f++)
+		{
+			buildAABBBatchScalar(posX.data(), posY.data(), halfW.data(), halfH.data(), minX.data(), minY.data(), maxX.data(), maxY.data(), n);
+			nScalar = overlapOneVsManyIndicesScalar(box, columns, n, hitsScalar.data());
+		}
+		doNotOptimize(nScalar);
+	});
+
+	double simdMs = bestOf(3, [&]() {
+		for (int f = 0; f < frames; f++)
+		{
+			buildAABBBatch(posX.data(), posY.data(), halfW.data(), halfH.data(), minX.data(), minY.data(), maxX.data(), maxY.data(), n);
+			nSimd = overlapOneVsManyIndices(box, columns, n, hitsSimd.data());
+		}
+		doNotOptimize(nSimd);
+	});
+
+	double maskMs = bestOf(3, [&]() {
+		for (int f = 0; f < frames; f++)
+		{
+			buildAABBBatch(posX.data(), posY.data(), halfW.data(), halfH.data(), minX.data(), minY.data(), maxX.data(), maxY.data(), n);
+			nMask = overlapOneVsMany(box, columns, n, mask.data());
+		}
+		doNotOptimize(nMask);
+	});
+
+	bool same = nRef == nScalar && nRef == nSimd && nRef == nMask;
+	for (uint32_t h = 0; same && h < nRef; h++)
+	{
+		same = hitsRef[h] == hitsScalar[h] && hitsRef[h] == hitsSimd[h] && ((mask[hitsRef[h] / 64] >> (hitsRef[h] % 64)) & 1);
+	}
+
+	double perFrame = (double)frames;
+	printf("%-40s %9.3f ms/frame\n", "calculateAABB + checkCollision(valor)", refMs / perFrame);
+	printf("%-40s %9.3f ms/frame  (%.1fx)\n", "lote escalar (SoA)", scalarMs / perFrame, refMs / scalarMs);
+	printf("%-40s %9.3f ms/frame  (%.1fx)\n", "lote SIMD -> indices", simdMs / perFrame, refMs / simdMs);
+	printf("%-40s %9.3f ms/frame  (%.1fx)\n", "lote SIMD -> bitmask", maskMs / perFrame, refMs / maskMs);
+	printf("\n%u colisoes; resultados %s\n", nRef, same ? "identicos" : "DIFERENTES");
+
+	// N contra M: 1000 caixas contra o lote inteiro
+	std::vector<uint32_t> pairsA(1 << 20), pairsB(1 << 20);
+	AABBColumns first1000 = columns;
+	uint32_t pairs = 0;
+	double nmMs = bestOf(3, [&]() {
+		pairs = overlapManyVsMany(first1000, 1000, columns, n, pairsA.data(), pairsB.data(), (uint32_t)pairsA.size());
+		doNotOptimize(pairs);
+	});
+	printf("1000 x %u caixas: %u pares em %.2f ms (%.2f ns/teste)\n", n, pairs, nmMs, nmMs * 1e6 / (1000.0 * n));
+	return same ? 0 : 1;
+}
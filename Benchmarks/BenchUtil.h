@@ -0,0 +1,46 @@
+// Utilitários compartilhados pelos benchmarks: cronômetro e barreira contra o otimizador
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+struct BenchTimer
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	double elapsedMs() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+// Impede que o compilador descarte um resultado que só é usado pelo benchmark
+template <class T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static volatile const void *sink;
+	sink = &value;
+#endif
+}
+
+// Roda "body" algumas vezes e devolve o menor tempo em ms (menos sensível a ruído do SO)
+template <class F>
+inline double bestOf(int runs, F body)
+{
+	double best = 1e30;
+	for (int r = 0; r < runs; r++)
+	{
+		BenchTimer timer;
+		body();
+		double ms = timer.elapsedMs();
+		if (ms < best)
+		{
+			best = ms;
+		}
+	}
+	return best;
+}
@@ -0,0 +1,93 @@
+/* Benchmark do EntityPool
+ * Compara o reciclamento antigo dos itens (cópia do Sprite protótipo para dentro de um
+ * vector<Sprite>) com spawn/despawn pelo pool de handles, na mesma sequência aleatória.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glm/glm.hpp>
+#include "EntityPool.h"
+#include "BenchUtil.h"
+
+using namespace glm;
+
+// Mesmo layout do Sprite do jogo (ids GL guardados como GLfloat)
+struct Sprite
+{
+	float VAO, textureID;
+	vec3 pos, dimensions;
+	float angle;
+	int nAnimations, nFrames, iAnimation, iFrame;
+	float ds, dt;
+	float vel;
+	vec2 PMax, PMin;
+	int effect;
+};
+
+struct Item
+{
+	int prototype;
+	vec3 pos;
+	float vel;
+	vec2 PMax, PMin;
+};
+
+int main()
+{
+	const uint32_t capacity = 100000;
+	const int operations = 10000000;
+
+	std::vector<uint32_t> victims(operations);
+	srand(42);
+	for (int i = 0; i < operations; i++)
+	{
+		victims[i] = (uint32_t)rand() % capacity;
+	}
+
+	Sprite prototypes[2] = {};
+	prototypes[1].effect = 1;
+
+	// Antes: items[i] = prototipo
+	std::vector<Sprite> sprites;
+	for (uint32_t i = 0; i < capacity; i++)
+	{
+		sprites.push_back(prototypes[i & 1]);
+	}
+	double copyMs = bestOf(5, [&]() {
+		for (int i = 0; i < operations; i++)
+		{
+			Sprite &s = sprites[victims[i]];
+			s = prototypes[i & 1];
+			s.pos.y = 600.0f;
+		}
+		doNotOptimize(sprites[0]);
+	});
+
+	// Depois: despawn + spawn pelo pool, referenciando o protótipo pelo id
+	EntityPool pool(capacity);
+	std::vector<Item> items(capacity);
+	for (uint32_t i = 0; i < capacity; i++)
+	{
+		items[pool.denseIndex(pool.spawn())].prototype = i & 1;
+	}
+	double poolMs = bestOf(5, [&]() {
+		for (int i = 0; i < operations; i++)
+		{
+			DenseMove move;
+			pool.despawn(pool.handleAt(victims[i] % pool.size()), move);
+			applyDenseMove(items.data(), move);
+
+			EntityHandle handle = pool.spawn();
+			Item &item = items[pool.denseIndex(handle)];
+			item.prototype = i & 1;
+			item.pos = vec3(0.0f, 600.0f, 0.0f);
+		}
+		doNotOptimize(items[0]);
+	});
+
+	printf("sizeof(Sprite) = %zu bytes, sizeof(Item) = %zu bytes\n", sizeof(Sprite), sizeof(Item));
+	printf("copia do prototipo : %8.2f ms  (%6.1f M respawns/s)\n", copyMs, operations / copyMs / 1000.0);
+	printf("EntityPool         : %8.2f ms  (%6.1f M spawn+despawn/s)\n", poolMs, operations / poolMs / 1000.0);
+	return 0;
+}
@@ -0,0 +1,128 @@
+/* Benchmark das aproximações de FastMath.h contra a libm
+ * 1M avaliações de cada função, em três variantes:
+ *   libm       - std::sin + std::cos, std::atan2 e 1 / std::sqrt, um elemento por vez
+ *   rapida     - a versão inline de FastMath.h chamada no laço, como num ponto de uso
+ *   lote       - a versão em lote de FastMath.cpp, vetorizada pelo compilador
+ * O erro máximo é medido contra a libm em double, nos mesmos dados, e deve ficar dentro do
+ * documentado em FastMath.h (a coluna "limite"); se algum passar, o benchmark sai com 1.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "FastMath.h"
+#include "BenchUtil.h"
+
+const uint32_t N = 1000000;
+const int RUNS = 10;
+
+float uniform(float lo, float hi)
+{
+	return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+// Devolve false se o erro passou do limite
+bool report(const char *name, double libmMs, double inlineMs, double batchMs, double error, double limit)
+{
+	printf("%10s %10.3f %10.3f %10.3f %8.1fx %8.1fx %10.2e %10.2e %6s\n", name, libmMs, inlineMs, batchMs, libmMs / inlineMs,
+		   libmMs / batchMs, error, limit, error <= limit ? "ok" : "ACIMA");
+	return error <= limit;
+}
+
+int main()
+{
+	std::vector<float> a(N), b(N), out1(N), out2(N);
+	srand(3);
+	bool withinLimits = true;
+
+	printf("%u avaliacoes, melhor de %d\n\n", N, RUNS);
+	printf("%10s %10s %10s %10s %9s %9s %10s %10s\n", "", "libm ms", "rapida ms", "lote ms", "rapida", "lote", "erro max", "limite");
+
+	// sincos: ângulos de uma simulação, e o erro medido até |x| = 1e4
+	for (uint32_t i = 0; i < N; i++)
+	{
+		a[i] = uniform(-1e4f, 1e4f);
+	}
+	double libmMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			out1[i] = std::sin(a[i]);
+			out2[i] = std::cos(a[i]);
+		}
+		doNotOptimize(out1[0]);
+	});
+	double inlineMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			fastSinCos(a[i], out1[i], out2[i]);
+		}
+		doNotOptimize(out1[0]);
+	});
+	double batchMs = bestOf(RUNS, [&]() { fastSinCos(a.data(), out1.data(), out2.data(), N); });
+	double error = 0.0;
+	for (uint32_t i = 0; i < N; i++)
+	{
+		error = std::max(error, std::fabs(out1[i] - std::sin((double)a[i])));
+		error = std::max(error, std::fabs(out2[i] - std::cos((double)a[i])));
+	}
+	withinLimits = report("sincos", libmMs, inlineMs, batchMs, error, 1.5e-7) && withinLimits;
+
+	// atan2: direções em volta da origem, com alguns eixos e a origem exatos
+	for (uint32_t i = 0; i < N; i++)
+	{
+		a[i] = (i % 97 == 0) ? 0.0f : uniform(-1000.0f, 1000.0f);
+		b[i] = (i % 89 == 0) ? 0.0f : uniform(-1000.0f, 1000.0f);
+	}
+	libmMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			out1[i] = std::atan2(a[i], b[i]);
+		}
+		doNotOptimize(out1[0]);
+	});
+	inlineMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			out1[i] = fastAtan2(a[i], b[i]);
+		}
+		doNotOptimize(out1[0]);
+	});
+	batchMs = bestOf(RUNS, [&]() { fastAtan2(a.data(), b.data(), out1.data(), N); });
+	error = 0.0;
+	for (uint32_t i = 0; i < N; i++)
+	{
+		error = std::max(error, std::fabs(out1[i] - std::atan2((double)a[i], (double)b[i])));
+	}
+	withinLimits = report("atan2", libmMs, inlineMs, batchMs, error, 2.5e-6) && withinLimits;
+
+	// rsqrt: distâncias ao quadrado de 1e-6 a 1e6, uniformes em escala logarítmica
+	for (uint32_t i = 0; i < N; i++)
+	{
+		a[i] = std::pow(10.0f, uniform(-6.0f, 6.0f));
+	}
+	libmMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			out1[i] = 1.0f / std::sqrt(a[i]);
+		}
+		doNotOptimize(out1[0]);
+	});
+	inlineMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			out1[i] = fastRsqrt(a[i]);
+		}
+		doNotOptimize(out1[0]);
+	});
+	batchMs = bestOf(RUNS, [&]() { fastRsqrt(a.data(), out1.data(), N); });
+	error = 0.0;
+	for (uint32_t i = 0; i < N; i++)
+	{
+		double exact = 1.0 / std::sqrt((double)a[i]);
+		error = std::max(error, std::fabs(out1[i] - exact) / exact);
+	}
+	withinLimits = report("rsqrt", libmMs, inlineMs, batchMs, error, 6.6e-4) && withinLimits;
+	return withinLimits ? 0 : 1;
+}
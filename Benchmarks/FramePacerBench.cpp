@@ -0,0 +1,84 @@
+/* Benchmark do frame pacing
+ * 1. Precisão da espera: sleep_until puro contra a espera híbrida (sleep + spin), 5 ms por espera.
+ * 2. Os quatro modos com um frame sintético de ~4 ms de trabalho a 60 Hz. O vsync é simulado:
+ *    o "swap" bloqueia até o próximo múltiplo do período, como o driver faria. A latência é do
+ *    instante em que a entrada seria lida (fim de beginFrame) até o swap retornar.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+#include "FramePacer.h"
+#include "BenchUtil.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static double toMs(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+
+static void spinFor(double ms)
+{
+	Clock::time_point end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+	while (Clock::now() < end)
+	{
+	}
+}
+
+int main()
+{
+	// 1. Precisão da espera
+	{
+		const int waits = 100;
+		double plainMean = 0.0, plainMax = 0.0, hybridMean = 0.0, hybridMax = 0.0;
+		FramePacer pacer(PACING_CAPPED, 60.0);
+		for (int i = 0; i < waits; i++)
+		{
+			Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(5);
+			std::this_thread::sleep_until(deadline);
+			double late = toMs(Clock::now() - deadline);
+			plainMean += late / waits;
+			plainMax = std::max(plainMax, late);
+
+			deadline = Clock::now() + std::chrono::milliseconds(5);
+			pacer.sleepUntil(deadline);
+			late = toMs(Clock::now() - deadline);
+			hybridMean += late / waits;
+			hybridMax = std::max(hybridMax, late);
+		}
+		printf("atraso de uma espera de 5 ms (ms):\n");
+		printf("%16s media %7.3f  max %7.3f\n", "sleep_until", plainMean, plainMax);
+		printf("%16s media %7.3f  max %7.3f\n\n", "hibrida", hybridMean, hybridMax);
+	}
+
+	// 2. Modos
+	const double fps = 60.0, period = 1000.0 / fps;
+	const int frames = 120;
+	printf("%20s %7s %7s %7s %8s %8s %8s %10s\n", "modo", "p50", "p99", "desvio", "trab.", "sleep", "spin", "latencia");
+	for (int m = 0; m < NUM_PACING_MODES; m++)
+	{
+		FramePacer pacer((PacingMode)m, fps);
+		Clock::time_point origin = Clock::now();
+		double latency = 0.0;
+		srand(9);
+		for (int f = 0; f < frames; f++)
+		{
+			pacer.beginFrame();
+			Clock::time_point input = Clock::now();
+			spinFor(3.0 + (rand() % 2000) / 1000.0); // trabalho do frame: 3 a 5 ms
+			pacer.beforeSwap();
+			if (pacer.swapInterval() == 1)
+			{
+				// vsync simulado: bloqueia até o próximo vblank
+				double elapsed = toMs(Clock::now() - origin);
+				spinFor((std::floor(elapsed / period) + 1.0) * period - elapsed);
+			}
+			latency += toMs(Clock::now() - input) / frames;
+			pacer.endFrame();
+		}
+		FrameStats s = pacer.stats();
+		printf("%20s %7.2f %7.2f %7.3f %8.2f %8.2f %8.2f %10.2f\n", FramePacer::modeName((PacingMode)m), s.p50, s.p99, s.stddev,
+			   s.workMean, s.sleepMean, s.spinMean, latency);
+	}
+	return 0;
+}
@@ -0,0 +1,80 @@
+/* Benchmark da geração de geometria
+ * Círculo de 10^3 a 10^7 vértices:
+ *   original  - cos/sin por vértice e push_back num vector que cresce (como createCircle);
+ *   tabela    - SinCosTable + generateCircle numa thread (malha indexada);
+ *   paralelo  - o mesmo com o JobSystem usando todas as threads.
+ * O tempo da tabela inclui construí-la. O erro é o maior desvio da borda em relação a
+ * radius * cos/sin calculados em double.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "Geometry.h"
+#include "JobSystem.h"
+#include "BenchUtil.h"
+
+static const float Pi = 3.14159;
+
+// Cópia do laço de createCircle (sem a parte de OpenGL)
+static void originalCircle(std::vector<float> &vertices, int nPoints, float radius)
+{
+	vertices.clear();
+	vertices.shrink_to_fit();
+	float angle = 0.0;
+	float slice = 2 * Pi / (float)nPoints;
+	vertices.push_back(0.0);
+	vertices.push_back(0.0);
+	vertices.push_back(0.0);
+	for (int i = 0; i < nPoints + 1; i++)
+	{
+		vertices.push_back(radius * cos(angle));
+		vertices.push_back(radius * sin(angle));
+		vertices.push_back(0.0);
+		angle = angle + slice;
+	}
+}
+
+static double maxError(const float *vertices, uint32_t n, float radius, uint32_t stride)
+{
+	double worst = 0.0;
+	for (uint32_t i = 0; i < n; i += stride)
+	{
+		double angle = 6.283185307179586 * i / n;
+		double dx = vertices[3 * (i + 1)] - radius * std::cos(angle);
+		double dy = vertices[3 * (i + 1) + 1] - radius * std::sin(angle);
+		worst = std::max(worst, std::sqrt(dx * dx + dy * dy));
+	}
+	return worst;
+}
+
+int main()
+{
+	JobSystem jobs(std::max(2u, std::thread::hardware_concurrency()));
+	const float radius = 0.5f;
+	printf("threads: %u\n", jobs.threadCount());
+	printf("%10s %12s %12s %12s %12s %12s\n", "vertices", "original ms", "tabela ms", "paralelo ms", "erro orig.", "erro tabela");
+	for (uint32_t n = 1000; n <= 10000000; n *= 10)
+	{
+		int runs = n >= 1000000 ? 3 : 10;
+		std::vector<float> original;
+		double originalMs = bestOf(runs, [&]() { originalCircle(original, n, radius); });
+
+		Mesh mesh;
+		double tableMs = bestOf(runs, [&]() {
+			SinCosTable table(n);
+			generateCircle(mesh, table, radius);
+		});
+		double tableError = maxError(mesh.vertices.data(), n, radius, std::max(1u, n / 100000));
+
+		double parallelMs = bestOf(runs, [&]() {
+			SinCosTable table(n, &jobs);
+			generateCircle(mesh, table, radius, &jobs);
+		});
+
+		double originalError = maxError(original.data(), n, radius, std::max(1u, n / 100000));
+		printf("%10u %12.3f %12.3f %12.3f %12.2e %12.2e\n", n, originalMs, tableMs, parallelMs, originalError, tableError);
+	}
+	return 0;
+}
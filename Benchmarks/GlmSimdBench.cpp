@@ -0,0 +1,142 @@
+/* Benchmark da glm escalar contra a glm com intrínsecos (tipos alinhados)
+ * As duas versões dos tipos de GlmConfig.h (highp, a build sem GLM_SIMD_MATH, e aligned_highp, a
+ * build com ele) compiladas lado a lado, 100k sprites cada:
+ *   matrizes - translate/rotate/scale do sprite e o produto pela projeção ortográfica
+ *   AABBs    - min/max a partir de posição e dimensões em vec4, e o teste de sobreposição
+ *              contra a caixa do personagem, como calculateAABB e checkCollisions do jogo
+ * Confere que a versão SIMD dá as mesmas matrizes (tolerância relativa de 1e-5, a ordem das somas
+ * muda) e exatamente as mesmas caixas e colisões da escalar.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "GlmConfig.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include "BenchUtil.h"
+
+const uint32_t N = 100000;
+const int RUNS = 20;
+
+struct SpriteInput
+{
+	float x, y, width, height, angle;
+};
+
+template <glm::precision P>
+struct Results
+{
+	std::vector<glm::tmat4x4<float, P>> matrices;
+	std::vector<glm::tvec4<float, P>> mins, maxs;
+	uint32_t hits = 0;
+	double matrixMs = 0.0, aabbMs = 0.0;
+};
+
+template <glm::precision P>
+Results<P> run(const std::vector<SpriteInput> &input)
+{
+	typedef glm::tvec3<float, P> vec3;
+	typedef glm::tvec4<float, P> vec4;
+	typedef glm::tmat4x4<float, P> mat4;
+
+	Results<P> r;
+	r.matrices.resize(N);
+	r.mins.resize(N);
+	r.maxs.resize(N);
+
+	// Entidades como no Sprite do jogo: posição com w = 1 e dimensões com z = w = 0
+	std::vector<vec4> pos(N), dimensions(N);
+	for (uint32_t i = 0; i < N; i++)
+	{
+		pos[i] = vec4(input[i].x, input[i].y, 0.0f, 1.0f);
+		dimensions[i] = vec4(input[i].width, input[i].height, 0.0f, 0.0f);
+	}
+	const mat4 projection(glm::ortho(0.0f, 800.0f, 0.0f, 600.0f, -1.0f, 1.0f));
+
+	r.matrixMs = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			mat4 model = glm::translate(mat4(1.0f), vec3(pos[i]));
+			model = glm::rotate(model, input[i].angle, vec3(0.0f, 0.0f, 1.0f));
+			model = glm::scale(model, vec3(dimensions[i].x, dimensions[i].y, 1.0f));
+			r.matrices[i] = projection * model;
+		}
+		doNotOptimize(r.matrices[0]);
+	});
+
+	const vec4 playerMin(380.0f, 80.0f, 0.0f, 1.0f), playerMax(420.0f, 120.0f, 0.0f, 1.0f);
+	r.aabbMs = bestOf(RUNS, [&]() {
+		uint32_t hits = 0;
+		for (uint32_t i = 0; i < N; i++)
+		{
+			vec4 half = dimensions[i] * 0.5f;
+			vec4 lo = pos[i] - half, hi = pos[i] + half;
+			r.mins[i] = lo;
+			r.maxs[i] = hi;
+			// z e w são iguais nas duas caixas, então só x e y decidem
+			hits += glm::all(glm::lessThanEqual(lo, playerMax)) && glm::all(glm::lessThanEqual(playerMin, hi));
+		}
+		r.hits = hits;
+		doNotOptimize(r.mins[0]);
+	});
+	return r;
+}
+
+template <class A, class B>
+bool closeEnough(const A &a, const B &b)
+{
+	for (int c = 0; c < 4; c++)
+	{
+		for (int k = 0; k < 4; k++)
+		{
+			if (std::fabs(a[c][k] - b[c][k]) > 1e-5f * (1.0f + std::fabs(a[c][k])))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	std::vector<SpriteInput> input(N);
+	srand(3);
+	for (uint32_t i = 0; i < N; i++)
+	{
+		input[i].x = (float)(rand() % 8000) * 0.1f;
+		input[i].y = (float)(rand() % 6000) * 0.1f;
+		input[i].width = 16.0f + rand() % 48;
+		input[i].height = 16.0f + rand() % 48;
+		input[i].angle = (rand() % 360) * 0.0174533f;
+	}
+
+#ifdef GLM_SIMD_MATH
+	printf("GLM_SIMD_MATH definido (math_vec4 e math_mat4 alinhados)");
+#else
+	printf("GLM_SIMD_MATH nao definido (math_vec4 e math_mat4 escalares)");
+#endif
+	printf(", alinhamento de aligned_vec4: %u, %u sprites, melhor de %d\n\n", (unsigned)alignof(glm::aligned_vec4), N, RUNS);
+
+	Results<glm::highp> scalar = run<glm::highp>(input);
+	Results<glm::aligned_highp> simd = run<glm::aligned_highp>(input);
+
+	bool sameMatrices = true, sameBoxes = scalar.hits == simd.hits;
+	for (uint32_t i = 0; i < N; i++)
+	{
+		sameMatrices = sameMatrices && closeEnough(scalar.matrices[i], simd.matrices[i]);
+		for (int k = 0; k < 4; k++)
+		{
+			sameBoxes = sameBoxes && scalar.mins[i][k] == simd.mins[i][k] && scalar.maxs[i][k] == simd.maxs[i][k];
+		}
+	}
+
+	printf("%10s %12s %12s %10s %10s\n", "", "escalar ms", "SIMD ms", "ganho", "confere");
+	printf("%10s %12.3f %12.3f %9.2fx %10s\n", "matrizes", scalar.matrixMs, simd.matrixMs, scalar.matrixMs / simd.matrixMs,
+		   sameMatrices ? "ok" : "DIFERENTE");
+	printf("%10s %12.3f %12.3f %9.2fx %10s\n", "AABBs", scalar.aabbMs, simd.aabbMs, scalar.aabbMs / simd.aabbMs,
+		   sameBoxes ? "ok" : "DIFERENTE");
+	printf("colisoes com o personagem: %u (escalar) e %u (SIMD)\n", scalar.hits, simd.hits);
+	return sameMatrices && sameBoxes ? 0 : 1;
+}
@@ -0,0 +1,691 @@
+/* Regressão de renderização: imagens de referência e orçamentos por cena
+ * Renderiza cenas roteirizadas (sem tempo nem aleatoriedade) num HeadlessContext, lê o FBO com
+ * glReadPixels e compara com golden/<cena>.png pela diferença perceptual do ImageCompare. Cada
+ * cena também tem orçamento de draw calls (RenderStats) e de tempo de frame (mediana de FRAMES
+ * frames, cada um fechado com glFinish). Uma otimização só entra se todas as cenas passarem.
+ *   sprites_jogo   - o jogo com as texturas reais: o fundo em parallax, com as camadas deslocadas,
+ *                    e o personagem e os itens pelo SpriteRenderer
+ *   sprites_stress - 2000 sprites girando em 4 camadas, o caso do batching por camada
+ *   circulo        - círculo e estrela preenchidos, contorno e espiral do módulo Geometry
+ *   transforms     - o triângulo do HelloTransform em quatro instantes fixos
+ *   tilemap        - mapa de 256x256 tiles em duas camadas (atlas do pixelWall.png), rolado até o
+ *                    meio: só os chunks na tela são desenhados
+ * Uso (rodar da pasta Benchmarks): GoldenImages [--update] [--time-scale X] [cena...]
+ *   --update regrava as referências; --time-scale multiplica os orçamentos de tempo (calibrados
+ *   no llvmpipe da Mesa com um núcleo). Em falha, golden_out/ recebe a imagem obtida e o diff.
+ * Sai com 1 se alguma cena falhar. Build: tarefa "build golden images (EGL)" do tasks.json.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <stb_image.h>
+#include "HeadlessContext.h"
+#include "SpriteRenderer.h"
+#include "RenderStats.h"
+#include "Geometry.h"
+#include "TileMap.h"
+#include "ParallaxBackground.h"
+#include "ShaderUtil.h"
+#include "PngWriter.h"
+#include "ImageCompare.h"
+#include "BenchUtil.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define makeDirectory(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define makeDirectory(path) mkdir(path, 0755)
+#endif
+
+const int WIDTH = 400, HEIGHT = 300; // metade da janela do jogo: referências menores, mesma cena
+const int FRAMES = 30;
+const float THRESHOLD = 0.1f;
+
+struct Scene
+{
+	const char *name;
+	bool (*setup)();
+	void (*draw)();
+	void (*teardown)();
+	uint32_t maxDrawCalls;
+	double maxFrameMs;	 // mediana, no llvmpipe com um núcleo
+	double maxDifferent; // fração de pixels diferentes aceita
+};
+
+JobSystem *jobs = nullptr;
+
+GLuint uploadTexture(const uint8_t *rgba, int width, int height)
+{
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return texture;
+}
+
+// Como o loadTexture do jogo, sempre em RGBA
+GLuint loadTexture(const char *path, int &width, int &height)
+{
+	int channels;
+	unsigned char *data = stbi_load(path, &width, &height, &channels, 4);
+	if (data == nullptr)
+	{
+		printf("Failed to load texture %s\n", path);
+		return 0;
+	}
+	GLuint texture = uploadTexture(data, width, height);
+	stbi_image_free(data);
+	return texture;
+}
+
+// Projeção do jogo: 0..800 x 0..600, qualquer que seja a viewport
+glm::mat4 gameProjection()
+{
+	return glm::ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);
+}
+
+namespace gameScene
+{
+	enum { LAYER_CHARACTER, LAYER_FRUIT, LAYER_ICECUBE, NUM_LAYERS };
+
+	// Mesmas faixas, velocidades e scroll do main do jogo; o scroll é o do personagem em x = 100
+	const float BACKGROUND_ROWS[] = { 0, 216, 999, 1236, 1296 }, BACKGROUND_SCALE = 600.0f / 1296;
+	const float BACKGROUND_RATES[] = { 0.05f, 0.2f, 0.5f, 0.8f }, BACKGROUND_DRIFTS[] = { 6.0f, 0.0f, 0.0f, 0.0f };
+	const float SCROLL = -300.0f, SECONDS = 10.0f;
+
+	SpriteRenderer *renderer = nullptr;
+	ParallaxBackground *background = nullptr;
+	GLuint textures[NUM_LAYERS], backgroundSheet = 0;
+	std::vector<InstanceSprite> sprites;
+
+	InstanceSprite sprite(uint32_t layer, float x, float y, float width, float height)
+	{
+		InstanceSprite s = {};
+		s.x = x;
+		s.y = y;
+		s.width = width;
+		s.height = height;
+		s.du = s.dv = 1.0f;
+		s.tint = 0xFFFFFFFFu;
+		s.layer = layer;
+		return s;
+	}
+
+	bool setup()
+	{
+		int w[NUM_LAYERS], h[NUM_LAYERS];
+		textures[LAYER_CHARACTER] = loadTexture("../Textures/Characters/character.png", w[0], h[0]);
+		textures[LAYER_FRUIT] = loadTexture("../Textures/Items/fruit.png", w[1], h[1]);
+		textures[LAYER_ICECUBE] = loadTexture("../Textures/Items/icecube.png", w[2], h[2]);
+		for (GLuint texture : textures)
+		{
+			if (texture == 0)
+			{
+				return false;
+			}
+		}
+
+		background = new ParallaxBackground();
+		if (!background->init())
+		{
+			return false;
+		}
+		background->setProjection(glm::value_ptr(gameProjection()));
+		int sheetWidth, sheetHeight;
+		backgroundSheet = loadTexture("../Textures/Backgrounds/parallax.png", sheetWidth, sheetHeight);
+		if (backgroundSheet == 0)
+		{
+			return false;
+		}
+		background->setSheet(backgroundSheet);
+		for (uint32_t i = 0; i < MAX_PARALLAX_LAYERS; i++)
+		{
+			background->addLayer(BACKGROUND_ROWS[i] / 1296, BACKGROUND_ROWS[i + 1] / 1296, 600.0f - BACKGROUND_ROWS[i + 1] * BACKGROUND_SCALE,
+								 600.0f - BACKGROUND_ROWS[i] * BACKGROUND_SCALE, BACKGROUND_RATES[i], BACKGROUND_DRIFTS[i]);
+		}
+
+		// Mesmas escalas do main do jogo; o personagem no quadro 3 da animação de andar para a direita
+		sprites.clear();
+		InstanceSprite character = sprite(LAYER_CHARACTER, 100, 100, w[0] * 3.0f / 6, h[0] * 3.0f / 3);
+		character.du = 1.0f / 6;
+		character.dv = 1.0f / 3;
+		character.u0 = 3 * character.du;
+		character.v0 = 2 * character.dv;
+		sprites.push_back(character);
+		const float fruits[][2] = { {80, 520}, {210, 430}, {330, 560}, {520, 350}, {640, 470}, {730, 250} };
+		for (const auto &p : fruits)
+		{
+			sprites.push_back(sprite(LAYER_FRUIT, p[0], p[1], w[1] * 0.1f, h[1] * 0.1f));
+		}
+		const float icecubes[][2] = { {150, 300}, {450, 480}, {600, 180} };
+		for (const auto &p : icecubes)
+		{
+			sprites.push_back(sprite(LAYER_ICECUBE, p[0], p[1], w[2] * 1.5f, h[2] * 1.5f));
+		}
+
+		renderer = new SpriteRenderer(NUM_LAYERS, (uint32_t)sprites.size());
+		if (!renderer->init())
+		{
+			return false;
+		}
+		renderer->setProjection(glm::value_ptr(gameProjection()));
+		return true;
+	}
+
+	void draw()
+	{
+		glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		background->draw(0.0f, 800.0f, SCROLL, SECONDS);
+		renderer->draw(*jobs, sprites.data(), (uint32_t)sprites.size(), textures);
+	}
+
+	void teardown()
+	{
+		if (background != nullptr)
+		{
+			background->shutdown();
+			delete background;
+			background = nullptr;
+		}
+		renderer->shutdown();
+		delete renderer;
+		renderer = nullptr;
+		glDeleteTextures(NUM_LAYERS, textures);
+		glDeleteTextures(1, &backgroundSheet);
+	}
+}
+
+namespace stressScene
+{
+	const uint32_t COUNT = 2000, LAYERS = 4, TEXTURE_SIZE = 32;
+
+	SpriteRenderer *renderer = nullptr;
+	GLuint textures[LAYERS];
+	std::vector<InstanceSprite> sprites;
+
+	bool setup()
+	{
+		// Xadrez num disco, uma cor por camada
+		const uint8_t colors[LAYERS][3] = { {230, 80, 60}, {70, 180, 90}, {60, 110, 230}, {240, 200, 60} };
+		std::vector<uint8_t> pixels(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+		for (uint32_t layer = 0; layer < LAYERS; layer++)
+		{
+			for (uint32_t y = 0; y < TEXTURE_SIZE; y++)
+			{
+				for (uint32_t x = 0; x < TEXTURE_SIZE; x++)
+				{
+					float dx = x + 0.5f - TEXTURE_SIZE / 2.0f, dy = y + 0.5f - TEXTURE_SIZE / 2.0f;
+					float shade = ((x / 8 + y / 8) & 1) ? 1.0f : 0.6f;
+					uint8_t *p = &pixels[(y * TEXTURE_SIZE + x) * 4];
+					p[0] = (uint8_t)(colors[layer][0] * shade);
+					p[1] = (uint8_t)(colors[layer][1] * shade);
+					p[2] = (uint8_t)(colors[layer][2] * shade);
+					p[3] = dx * dx + dy * dy < TEXTURE_SIZE * TEXTURE_SIZE / 4.0f ? 255 : 0;
+				}
+			}
+			textures[layer] = uploadTexture(pixels.data(), TEXTURE_SIZE, TEXTURE_SIZE);
+		}
+
+		// Gerador próprio: rand() muda entre bibliotecas C e a cena tem que ser a mesma em toda máquina
+		uint32_t seed = 12345;
+		auto next = [&seed](uint32_t range) {
+			seed = seed * 1664525u + 1013904223u;
+			return (seed >> 8) % range;
+		};
+		sprites.resize(COUNT);
+		for (InstanceSprite &s : sprites)
+		{
+			s.x = (float)next(800);
+			s.y = (float)next(600);
+			s.width = s.height = 12.0f + next(36);
+			s.angle = next(360) * 0.0174533f;
+			s.u0 = s.v0 = 0.0f;
+			s.du = s.dv = 1.0f;
+			s.tint = 0xFFFFFFFFu;
+			s.layer = next(LAYERS);
+		}
+
+		renderer = new SpriteRenderer(LAYERS, COUNT, true); // sprites girados: instância com a matriz 2x3
+		if (!renderer->init())
+		{
+			return false;
+		}
+		renderer->setProjection(glm::value_ptr(gameProjection()));
+		return true;
+	}
+
+	void draw()
+	{
+		glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		renderer->draw(*jobs, sprites.data(), COUNT, textures);
+	}
+
+	void teardown()
+	{
+		renderer->shutdown();
+		delete renderer;
+		renderer = nullptr;
+		glDeleteTextures(LAYERS, textures);
+	}
+}
+
+// Shaders dos exemplos: posição direta (Circulo) ou com projection * model (HelloTransform), cor uniforme
+const GLchar *COLOR_FRAGMENT = R"(
+	#version 400
+	uniform vec4 inputColor;
+	out vec4 color;
+	void main() { color = inputColor; }
+)";
+
+namespace circleScene
+{
+	const GLchar *VERTEX = R"(
+		#version 400
+		layout (location = 0) in vec3 position;
+		void main() { gl_Position = vec4(position.x, position.y, position.z, 1.0); }
+	)";
+
+	struct UploadedMesh
+	{
+		GLuint vao, vbo, ebo;
+		GLsizei indices, rim; // rim: vértices da borda (1..rim)
+	};
+
+	GLuint program = 0;
+	GLint colorLocation;
+	UploadedMesh circle, star, spiral;
+
+	// Como o uploadMesh do Circulo, deslocando os vértices para a cena caber numa imagem
+	UploadedMesh upload(const Mesh &mesh, float dx, float dy)
+	{
+		std::vector<float> vertices = mesh.vertices;
+		for (size_t v = 0; v < vertices.size(); v += 3)
+		{
+			vertices[v] += dx;
+			vertices[v + 1] += dy;
+		}
+		UploadedMesh uploaded;
+		uploaded.indices = (GLsizei)mesh.indices.size();
+		uploaded.rim = (GLsizei)mesh.vertexCount() - 1;
+		glGenVertexArrays(1, &uploaded.vao);
+		glBindVertexArray(uploaded.vao);
+		glGenBuffers(1, &uploaded.vbo);
+		glBindBuffer(GL_ARRAY_BUFFER, uploaded.vbo);
+		glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+		glGenBuffers(1, &uploaded.ebo);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, uploaded.ebo);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(uint32_t), mesh.indices.data(), GL_STATIC_DRAW);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid *)0);
+		glEnableVertexAttribArray(0);
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		return uploaded;
+	}
+
+	void release(UploadedMesh &mesh)
+	{
+		glDeleteVertexArrays(1, &mesh.vao);
+		glDeleteBuffers(1, &mesh.vbo);
+		glDeleteBuffers(1, &mesh.ebo);
+	}
+
+	bool setup()
+	{
+		program = buildProgram(VERTEX, COLOR_FRAGMENT);
+		colorLocation = glGetUniformLocation(program, "inputColor");
+		Mesh mesh;
+		generateCircle(mesh, SinCosTable(64), 0.3f);
+		circle = upload(mesh, -0.5f, 0.45f);
+		generateStar(mesh, SinCosTable(10), 0.15f, 0.35f);
+		star = upload(mesh, 0.5f, 0.45f);
+		// Os parâmetros da espiral do Circulo, com menos voltas
+		generateSpiral(mesh, 8 * 3.14159f, 0.08f, 0.02f, 0.0012f);
+		spiral = upload(mesh, 0.0f, -0.45f);
+		return program != 0;
+	}
+
+	void draw()
+	{
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glUseProgram(program);
+
+		glBindVertexArray(circle.vao);
+		glUniform4f(colorLocation, 0.0f, 0.0f, 1.0f, 1.0f);
+		glDrawElements(GL_TRIANGLES, circle.indices, GL_UNSIGNED_INT, 0);
+
+		glBindVertexArray(star.vao);
+		glUniform4f(colorLocation, 1.0f, 1.0f, 0.0f, 1.0f);
+		glDrawElements(GL_TRIANGLES, star.indices, GL_UNSIGNED_INT, 0);
+		glUniform4f(colorLocation, 1.0f, 0.0f, 1.0f, 1.0f);
+		glDrawArrays(GL_LINE_LOOP, 1, star.rim);
+
+		glBindVertexArray(spiral.vao);
+		glUniform4f(colorLocation, 0.0f, 1.0f, 0.5f, 1.0f);
+		glDrawElements(GL_LINES, spiral.indices, GL_UNSIGNED_INT, 0);
+		glBindVertexArray(0);
+	}
+
+	void teardown()
+	{
+		release(circle);
+		release(star);
+		release(spiral);
+		glDeleteProgram(program);
+	}
+}
+
+namespace transformScene
+{
+	const GLchar *VERTEX = R"(
+		#version 400
+		layout (location = 0) in vec3 position;
+		uniform mat4 projection;
+		uniform mat4 model;
+		void main() { gl_Position = projection * model * vec4(position.x, position.y, position.z, 1.0); }
+	)";
+
+	GLuint program = 0, vao = 0, vbo = 0;
+	GLint colorLocation, modelLocation;
+
+	bool setup()
+	{
+		program = buildProgram(VERTEX, COLOR_FRAGMENT);
+		colorLocation = glGetUniformLocation(program, "inputColor");
+		modelLocation = glGetUniformLocation(program, "model");
+		glUseProgram(program);
+		glm::mat4 projection = gameProjection();
+		glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+
+		// O triângulo do setupGeometry do HelloTransform
+		GLfloat vertices[] = {
+			-0.5, -0.5, 0.0,
+			 0.5, -0.5, 0.0,
+			 0.0,  0.5, 0.0,
+		};
+		glGenBuffers(1, &vbo);
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+		glGenVertexArrays(1, &vao);
+		glBindVertexArray(vao);
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid *)0);
+		glEnableVertexAttribArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glBindVertexArray(0);
+		return program != 0;
+	}
+
+	void draw()
+	{
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glUseProgram(program);
+		glBindVertexArray(vao);
+
+		// O loop do HelloTransform com glfwGetTime() trocado por instantes fixos, um por quadrante
+		const float times[4] = { 0.3f, 0.9f, 2.2f, 2.9f };
+		const float centers[4][2] = { {200, 450}, {600, 450}, {200, 150}, {600, 150} };
+		for (int k = 0; k < 4; k++)
+		{
+			float t = times[k];
+			glm::mat4 model = glm::mat4(1);
+			model = glm::translate(model, glm::vec3(centers[k][0], centers[k][1], 0.0));
+			model = glm::rotate(model, t, glm::vec3(0.0, 0.0, 1.0));
+			model = glm::scale(model, glm::vec3(std::abs(std::cos(t)) * 250.0, std::abs(std::cos(t)) * 250.0, 1.0));
+			glUniformMatrix4fv(modelLocation, 1, GL_FALSE, glm::value_ptr(model));
+			glUniform4f(colorLocation, 0.0f, 0.0f, std::abs(std::cos(t)), 1.0f);
+			glDrawArrays(GL_TRIANGLES, 0, 3);
+		}
+		glBindVertexArray(0);
+	}
+
+	void teardown()
+	{
+		glDeleteVertexArrays(1, &vao);
+		glDeleteBuffers(1, &vbo);
+		glDeleteProgram(program);
+	}
+}
+
+namespace tileScene
+{
+	const uint32_t MAP_TILES = 256, ATLAS_COLUMNS = 4, ATLAS_ROWS = 4;
+	const float TILE_SIZE = 32.0f, CAMERA_X = 3000.0f, CAMERA_Y = 2000.0f;
+
+	TileMap *map = nullptr;
+	GLuint atlas = 0;
+
+	bool setup()
+	{
+		int width, height;
+		atlas = loadTexture("../Textures/pixelWall.png", width, height);
+		if (atlas == 0)
+		{
+			return false;
+		}
+		// A imagem é muito maior que o tile: sem mipmaps a redução vira ruído e muda entre drivers
+		glBindTexture(GL_TEXTURE_2D, atlas);
+		glGenerateMipmap(GL_TEXTURE_2D);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		map = new TileMap(MAP_TILES, MAP_TILES, 2, TILE_SIZE);
+		if (!map->init())
+		{
+			return false;
+		}
+		map->setAtlas(atlas, ATLAS_COLUMNS, ATLAS_ROWS);
+
+		// Camada 0: blocos de parede com vãos; camada 1: plataformas a cada 8 linhas
+		for (uint32_t y = 0; y < MAP_TILES; y++)
+		{
+			for (uint32_t x = 0; x < MAP_TILES; x++)
+			{
+				if ((x / 4 + y / 3) % 3 != 0)
+				{
+					map->setTile(0, x, y, (uint16_t)(1 + (x * 7 + y * 13) % (ATLAS_COLUMNS * ATLAS_ROWS)));
+				}
+				if (y % 8 == 0 && x % 16 < 12)
+				{
+					map->setTile(1, x, y, (uint16_t)(1 + x % 4));
+				}
+			}
+		}
+
+		glm::mat4 projection = glm::ortho(CAMERA_X, CAMERA_X + 800.0f, CAMERA_Y, CAMERA_Y + 600.0f, -1.0f, 1.0f);
+		map->setProjection(glm::value_ptr(projection));
+		return true;
+	}
+
+	void draw()
+	{
+		glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		map->draw(CAMERA_X, CAMERA_Y, CAMERA_X + 800.0f, CAMERA_Y + 600.0f);
+	}
+
+	void teardown()
+	{
+		if (map != nullptr)
+		{
+			map->shutdown();
+			delete map;
+			map = nullptr;
+		}
+		glDeleteTextures(1, &atlas);
+	}
+}
+
+const Scene SCENES[] = {
+	{ "sprites_jogo", gameScene::setup, gameScene::draw, gameScene::teardown, 4, 6.0, 0.002 },
+	{ "sprites_stress", stressScene::setup, stressScene::draw, stressScene::teardown, 4, 30.0, 0.002 },
+	// Linhas rasterizam diferente entre drivers: mais folga
+	{ "circulo", circleScene::setup, circleScene::draw, circleScene::teardown, 4, 2.0, 0.01 },
+	{ "transforms", transformScene::setup, transformScene::draw, transformScene::teardown, 4, 2.0, 0.002 },
+	// 2x2 chunks de 1024 pixels em cada camada, de 65536 tiles por camada
+	{ "tilemap", tileScene::setup, tileScene::draw, tileScene::teardown, 8, 6.0, 0.002 },
+};
+
+// glReadPixels devolve a linha de baixo primeiro; o PNG começa pela de cima
+void flipRows(std::vector<uint8_t> &rgba, int width, int height)
+{
+	const size_t stride = (size_t)width * 4;
+	std::vector<uint8_t> row(stride);
+	for (int y = 0; y < height / 2; y++)
+	{
+		uint8_t *top = &rgba[y * stride];
+		uint8_t *bottom = &rgba[(height - 1 - y) * stride];
+		memcpy(row.data(), top, stride);
+		memcpy(top, bottom, stride);
+		memcpy(bottom, row.data(), stride);
+	}
+}
+
+bool runScene(HeadlessContext &headless, const Scene &scene, bool update, double timeScale)
+{
+	if (!scene.setup())
+	{
+		printf("%-16s FALHOU: setup\n", scene.name);
+		scene.teardown();
+		return false;
+	}
+
+	// Um frame de aquecimento (compilação de shaders no driver, primeiros uploads) e o frame contado
+	scene.draw();
+	headless.finish();
+	beginRenderStats();
+	scene.draw();
+	const RenderStats stats = endRenderStats(0.0, 0.0, 0.0);
+	std::vector<uint8_t> image;
+	headless.readPixels(image);
+	flipRows(image, WIDTH, HEIGHT);
+
+	std::vector<double> times;
+	for (int f = 0; f < FRAMES; f++)
+	{
+		BenchTimer timer;
+		scene.draw();
+		headless.finish();
+		times.push_back(timer.elapsedMs());
+	}
+	std::sort(times.begin(), times.end());
+	double frameMs = times[FRAMES / 2];
+	scene.teardown();
+
+	std::string goldenPath = std::string("golden/") + scene.name + ".png";
+	if (update)
+	{
+		bool written = writePng(goldenPath.c_str(), image.data(), WIDTH, HEIGHT);
+		printf("%-16s %s (%u draws, %.2f ms)\n", scene.name, written ? "referencia gravada" : "FALHOU ao gravar", stats.drawCalls, frameMs);
+		return written;
+	}
+
+	int width, height, channels;
+	unsigned char *golden = stbi_load(goldenPath.c_str(), &width, &height, &channels, 4);
+	ImageDiff diff = {};
+	std::vector<uint8_t> diffImage(image.size());
+	bool sameSize = golden != nullptr && width == WIDTH && height == HEIGHT;
+	if (sameSize)
+	{
+		diff = compareImages(golden, image.data(), WIDTH, HEIGHT, THRESHOLD, diffImage.data());
+	}
+	stbi_image_free(golden);
+
+	bool imageOk = sameSize && diff.fraction <= scene.maxDifferent;
+	bool drawsOk = stats.drawCalls <= scene.maxDrawCalls;
+	bool timeOk = frameMs <= scene.maxFrameMs * timeScale;
+	printf("%-16s %8.3f%% %6s %4u/%-4u %6s %8.2f/%-8.2f %6s\n", scene.name, diff.fraction * 100.0, !sameSize ? "SEM REF" : imageOk ? "ok" : "FALHOU",
+		   stats.drawCalls, scene.maxDrawCalls, drawsOk ? "ok" : "FALHOU", frameMs, scene.maxFrameMs * timeScale, timeOk ? "ok" : "FALHOU");
+
+	if (!imageOk)
+	{
+		makeDirectory("golden_out");
+		std::string base = std::string("golden_out/") + scene.name;
+		writePng((base + ".png").c_str(), image.data(), WIDTH, HEIGHT);
+		if (sameSize)
+		{
+			writePng((base + ".diff.png").c_str(), diffImage.data(), WIDTH, HEIGHT);
+		}
+	}
+	return imageOk && drawsOk && timeOk;
+}
+
+int main(int argc, char **argv)
+{
+	bool update = false;
+	double timeScale = 1.0;
+	std::vector<std::string> only;
+	for (int a = 1; a < argc; a++)
+	{
+		if (strcmp(argv[a], "--update") == 0)
+		{
+			update = true;
+		}
+		else if (strcmp(argv[a], "--time-scale") == 0 && a + 1 < argc)
+		{
+			timeScale = atof(argv[++a]);
+		}
+		else
+		{
+			only.push_back(argv[a]);
+		}
+	}
+
+	HeadlessContext headless;
+	if (!headless.create(WIDTH, HEIGHT))
+	{
+		printf("sem contexto (%s): %s\n", HeadlessContext::backendName(), headless.error().c_str());
+		return 1;
+	}
+	installRenderStats();
+	printf("backend: %s, %s\n", HeadlessContext::backendName(), (const char *)glGetString(GL_RENDERER));
+
+	// Estado global do jogo
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glActiveTexture(GL_TEXTURE0);
+
+	JobSystem workers(std::max(2u, std::thread::hardware_concurrency()));
+	jobs = &workers;
+
+	if (update)
+	{
+		makeDirectory("golden");
+	}
+	else
+	{
+		printf("%-16s %9s %6s %9s %6s %17s %6s\n", "cena", "diferente", "", "draws", "", "frame ms", "");
+	}
+	int failures = 0;
+	for (const Scene &scene : SCENES)
+	{
+		if (only.empty() || std::find(only.begin(), only.end(), scene.name) != only.end())
+		{
+			failures += runScene(headless, scene, update, timeScale) ? 0 : 1;
+		}
+	}
+	headless.destroy();
+	if (failures > 0)
+	{
+		printf("%d cena(s) falharam; imagens em golden_out/\n", failures);
+	}
+	return failures > 0 ? 1 : 0;
+}
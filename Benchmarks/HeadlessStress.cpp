@@ -0,0 +1,175 @@
+/* Stress da renderização sem janela
+ * Sobe um HeadlessContext (EGL surfaceless, OSMesa ou janela oculta da GLFW) com um FBO 800x600,
+ * cria N sprites texturizados em 4 camadas e desenha com o SpriteRenderer do jogo. Os sprites
+ * andam e giram a cada frame, então o trabalho por frame é o do jogo: mover, gerar as instâncias
+ * e desenhar. Reporta frames/s, o tempo de CPU por frame (até o último comando enviado), o frame
+ * inteiro (com glFinish) e, do RenderStats, draws e bytes enviados por frame.
+ * Uso: HeadlessStress [sprites] [frames]; sem argumentos, 1k, 10k e 100k sprites.
+ * No Linux sem display: tarefa "build headless stress (EGL)" do tasks.json (-DHEADLESS_EGL -lEGL).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <glad/glad.h>
+#include "HeadlessContext.h"
+#include "SpriteRenderer.h"
+#include "RenderStats.h"
+#include "BenchUtil.h"
+
+const int WIDTH = 800, HEIGHT = 600;
+const uint32_t LAYERS = 4;
+const int TEXTURE_SIZE = 32;
+
+struct MovingSprite
+{
+	float vx, vy; // pixels por frame
+	float spin;	  // radianos por frame
+};
+
+// Disco com xadrez, uma cor por camada: transparência nas bordas, como os itens do jogo
+GLuint makeTexture(uint32_t layer)
+{
+	const uint8_t colors[LAYERS][3] = { {230, 80, 60}, {70, 180, 90}, {60, 110, 230}, {240, 200, 60} };
+	std::vector<uint8_t> pixels(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+	for (int y = 0; y < TEXTURE_SIZE; y++)
+	{
+		for (int x = 0; x < TEXTURE_SIZE; x++)
+		{
+			float dx = x + 0.5f - TEXTURE_SIZE / 2.0f, dy = y + 0.5f - TEXTURE_SIZE / 2.0f;
+			bool inside = dx * dx + dy * dy < TEXTURE_SIZE * TEXTURE_SIZE / 4.0f;
+			float shade = ((x / 8 + y / 8) & 1) ? 1.0f : 0.7f;
+			uint8_t *p = &pixels[(y * TEXTURE_SIZE + x) * 4];
+			p[0] = (uint8_t)(colors[layer][0] * shade);
+			p[1] = (uint8_t)(colors[layer][1] * shade);
+			p[2] = (uint8_t)(colors[layer][2] * shade);
+			p[3] = inside ? 255 : 0;
+		}
+	}
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, TEXTURE_SIZE, TEXTURE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return texture;
+}
+
+void runScene(HeadlessContext &headless, JobSystem &jobs, const GLuint *textures, uint32_t count, int frames)
+{
+	SpriteRenderer renderer(LAYERS, count, true); // os sprites giram
+	if (!renderer.init())
+	{
+		return;
+	}
+	// Projeção ortográfica 0..800 x 0..600, como no jogo
+	const float projection[16] = {
+		2.0f / WIDTH, 0.0f, 0.0f, 0.0f,
+		0.0f, 2.0f / HEIGHT, 0.0f, 0.0f,
+		0.0f, 0.0f, -1.0f, 0.0f,
+		-1.0f, -1.0f, 0.0f, 1.0f };
+	renderer.setProjection(projection);
+
+	std::vector<InstanceSprite> sprites(count);
+	std::vector<MovingSprite> motion(count);
+	srand(11);
+	for (uint32_t i = 0; i < count; i++)
+	{
+		InstanceSprite &s = sprites[i];
+		s.x = (float)(rand() % WIDTH);
+		s.y = (float)(rand() % HEIGHT);
+		s.width = s.height = 12.0f + rand() % 36;
+		s.angle = 0.0f;
+		s.u0 = s.v0 = 0.0f;
+		s.du = s.dv = 1.0f;
+		s.tint = 0xFFFFFFFFu;
+		s.layer = rand() % LAYERS;
+		motion[i].vx = (rand() % 200 - 100) / 50.0f;
+		motion[i].vy = (rand() % 200 - 100) / 50.0f;
+		motion[i].spin = (rand() % 100 - 50) / 1000.0f;
+	}
+
+	double cpuTotal = 0.0, frameTotal = 0.0;
+	uint64_t draws = 0, bytes = 0;
+	BenchTimer total;
+	for (int f = 0; f < frames; f++)
+	{
+		BenchTimer frame;
+		beginRenderStats();
+
+		// Movimento com rebote nas bordas
+		for (uint32_t i = 0; i < count; i++)
+		{
+			InstanceSprite &s = sprites[i];
+			MovingSprite &m = motion[i];
+			s.x += m.vx;
+			s.y += m.vy;
+			s.angle += m.spin;
+			if (s.x < 0.0f || s.x > WIDTH) { m.vx = -m.vx; }
+			if (s.y < 0.0f || s.y > HEIGHT) { m.vy = -m.vy; }
+		}
+
+		glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		renderer.draw(jobs, sprites.data(), count, textures);
+		double cpuMs = frame.elapsedMs();
+
+		headless.finish();
+		double frameMs = frame.elapsedMs();
+		const RenderStats &stats = endRenderStats(frameMs, cpuMs, 0.0);
+		cpuTotal += cpuMs;
+		frameTotal += frameMs;
+		draws += stats.drawCalls;
+		bytes += stats.bytesUploaded;
+	}
+	double seconds = total.elapsedMs() / 1000.0;
+
+	printf("%10u %10.1f %12.3f %12.3f %10.1f %12.1f\n", count, frames / seconds, cpuTotal / frames, frameTotal / frames,
+		   (double)draws / frames, bytes / 1024.0 / frames);
+	renderer.shutdown();
+}
+
+int main(int argc, char **argv)
+{
+	HeadlessContext headless;
+	if (!headless.create(WIDTH, HEIGHT))
+	{
+		printf("sem contexto (%s): %s\n", HeadlessContext::backendName(), headless.error().c_str());
+		return 1;
+	}
+	installRenderStats();
+	printf("backend: %s, %s, %s\n", HeadlessContext::backendName(), (const char *)glGetString(GL_RENDERER), (const char *)glGetString(GL_VERSION));
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glActiveTexture(GL_TEXTURE0);
+	GLuint textures[LAYERS];
+	for (uint32_t layer = 0; layer < LAYERS; layer++)
+	{
+		textures[layer] = makeTexture(layer);
+	}
+
+	JobSystem jobs(std::max(2u, std::thread::hardware_concurrency()));
+	int frames = argc > 2 ? atoi(argv[2]) : 60;
+	printf("%10s %10s %12s %12s %10s %12s\n", "sprites", "frames/s", "cpu ms", "frame ms", "draws", "KB enviados");
+	if (argc > 1)
+	{
+		runScene(headless, jobs, textures, (uint32_t)atoi(argv[1]), frames);
+	}
+	else
+	{
+		const uint32_t counts[] = { 1000, 10000, 100000 };
+		for (uint32_t count : counts)
+		{
+			runScene(headless, jobs, textures, count, frames);
+		}
+	}
+
+	glDeleteTextures(LAYERS, textures);
+	headless.destroy();
+	return 0;
+}
@@ -0,0 +1,117 @@
+/* Benchmark da entrada com instante
+ * 1. Precisão: 10 s de toques aleatórios de 2 a 40 ms numa simulação de 60 Hz, com linha do tempo
+ *    sintética. Compara amostrar o estado da tecla uma vez por tick (como antes) com integrar o
+ *    tempo pressionado dentro do tick. O deslocamento ideal é vel * tempo pressionado / tick.
+ * 2. Custo: push (com o carimbo do relógio) + advance por evento, numa thread só.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include "InputQueue.h"
+#include "BenchUtil.h"
+
+int main()
+{
+	const int64_t tick = 1000000000 / 60;
+	const int64_t duration = 10LL * 1000000000;
+	const int key = 65;
+	const float vel = 1.0f;
+
+	// 1. Precisão
+	{
+		InputQueue queue;
+		KeyboardState keyboard;
+		srand(11);
+
+		// Linha do tempo dos toques, em ns
+		const int maxTaps = 512;
+		int64_t pressAt[maxTaps], releaseAt[maxTaps];
+		int taps = 0;
+		double ideal = 0.0;
+		for (int64_t t = 5000000; taps < maxTaps; taps++)
+		{
+			t += 20000000 + (rand() % 60) * 1000000LL; // 20 a 80 ms entre toques
+			int64_t length = 2000000 + (rand() % 38) * 1000000LL;
+			if (t + length >= duration)
+			{
+				break;
+			}
+			pressAt[taps] = t;
+			releaseAt[taps] = t + length;
+			ideal += vel * (double)length / tick;
+			t += length;
+		}
+
+		float sampled = 0.0f, integrated = 0.0f;
+		int lostTaps = 0, pushed = 0;
+		bool sampledDown = false;
+		for (int64_t tickEnd = tick; tickEnd <= duration; tickEnd += tick)
+		{
+			// Os eventos do tick chegam antes do tick ser processado
+			for (; pushed < 2 * taps; pushed++)
+			{
+				int i = pushed / 2;
+				InputEvent event = { (pushed & 1) ? releaseAt[i] : pressAt[i], key, (pushed & 1) ? 0 : 1 };
+				if (event.timestamp >= tickEnd)
+				{
+					break;
+				}
+				queue.push(event);
+				if (event.action == 1)
+				{
+					sampledDown = true;
+				}
+				else
+				{
+					sampledDown = false;
+				}
+			}
+			keyboard.advance(queue, tickEnd - tick, tickEnd);
+
+			// Antes: só o estado no fim do tick conta; um toque que começou e terminou no tick se perde
+			if (sampledDown)
+			{
+				sampled += vel;
+			}
+			integrated += vel * keyboard.heldFraction(key);
+		}
+
+		// Toques inteiramente dentro de um tick: invisíveis para a amostragem
+		for (int i = 0; i < taps; i++)
+		{
+			if (pressAt[i] / tick == releaseAt[i] / tick)
+			{
+				lostTaps++;
+			}
+		}
+
+		printf("%d toques, %d mais curtos que o tick e dentro dele\n", taps, lostTaps);
+		printf("%14s %10s %10s\n", "", "deslocam.", "erro");
+		printf("%14s %10.2f %10s\n", "ideal", ideal, "");
+		printf("%14s %10.2f %9.2f%%\n", "amostrado", sampled, 100.0 * std::fabs(sampled - ideal) / ideal);
+		printf("%14s %10.2f %9.2f%%\n\n", "integrado", integrated, 100.0 * std::fabs(integrated - ideal) / ideal);
+	}
+
+	// 2. Custo por evento: lotes de 8 eventos por tick, como numa rajada de teclas
+	{
+		InputQueue queue;
+		KeyboardState keyboard;
+		const int ticks = 100000, batch = 8;
+		uint64_t applied = 0;
+		double ms = bestOf(3, [&]() {
+			for (int t = 0; t < ticks; t++)
+			{
+				for (int e = 0; e < batch; e++)
+				{
+					queue.push(key + e / 2, e & 1 ? 0 : 1);
+				}
+				int64_t now = inputClockNs() + 1;
+				applied += keyboard.advance(queue, now - tick, now);
+			}
+		});
+		doNotOptimize(applied);
+		printf("push + advance: %.1f ns por evento\n", ms * 1e6 / (ticks * batch));
+	}
+	return 0;
+}
@@ -0,0 +1,90 @@
+/* Benchmark da geração paralela de instâncias
+ * 100k sprites em 4 camadas. A referência é o laço serial que escreve uma instância por sprite,
+ * como o drawSprite fazia com a matriz de modelo, sem agrupar por camada. O InstanceBuilder
+ * agrupa por camada (counting sort em blocos) e escreve em paralelo com 1, 2, 4 e 8 threads.
+ * A saída é comparada com uma ordenação estável serial. Os dois formatos de instância são medidos:
+ * SpriteInstance<true> (seno e cosseno por sprite) e SpriteInstance<false> (o do jogo, só cópias).
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "InstanceBuilder.h"
+#include "BenchUtil.h"
+
+const uint32_t N = 100000;
+const uint32_t LAYERS = 4;
+
+template <bool Rotates>
+void measure(const char *title, const std::vector<InstanceSprite> &sprites)
+{
+	typedef SpriteInstance<Rotates> Instance;
+
+	// Referência: ordenação estável por camada, serial
+	std::vector<Instance> expected(N), out(N);
+	uint32_t cursor = 0;
+	for (uint32_t layer = 0; layer < LAYERS; layer++)
+	{
+		for (uint32_t i = 0; i < N; i++)
+		{
+			if (sprites[i].layer == layer)
+			{
+				writeInstance(sprites[i], expected[cursor++]);
+			}
+		}
+	}
+
+	double serialMs = bestOf(20, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			writeInstance(sprites[i], out[i]);
+		}
+		doNotOptimize(out[0]);
+	});
+
+	printf("\n%s, %u bytes por instancia\n", title, (unsigned)sizeof(Instance));
+	printf("%18s %10s %10s %10s\n", "", "ms", "ns/sprite", "confere");
+	printf("%18s %10.3f %10.2f %10s\n", "serial sem camada", serialMs, serialMs * 1e6 / N, "-");
+
+	const uint32_t threadCounts[] = { 1, 2, 4, 8 };
+	for (uint32_t threads : threadCounts)
+	{
+		JobSystem jobs(threads);
+		InstanceBuilder builder(LAYERS);
+		double ms = bestOf(20, [&]() { builder.build(jobs, sprites.data(), N, out.data()); });
+		bool same = std::memcmp(out.data(), expected.data(), N * sizeof(Instance)) == 0;
+
+		char label[32];
+		snprintf(label, sizeof(label), "%u threads", threads);
+		printf("%18s %10.3f %10.2f %10s\n", label, ms, ms * 1e6 / N, same ? "ok" : "DIFERENTE");
+	}
+}
+
+int main()
+{
+	std::vector<InstanceSprite> sprites(N);
+	srand(3);
+	for (uint32_t i = 0; i < N; i++)
+	{
+		InstanceSprite &s = sprites[i];
+		s.x = (float)(rand() % 800);
+		s.y = (float)(rand() % 600);
+		s.width = 16.0f + rand() % 48;
+		s.height = 16.0f + rand() % 48;
+		s.angle = (rand() % 360) * 0.0174533f;
+		s.u0 = (rand() % 6) / 6.0f;
+		s.v0 = (rand() % 3) / 3.0f;
+		s.du = 1.0f / 6.0f;
+		s.dv = 1.0f / 3.0f;
+		s.tint = 0xFFFFFFFFu;
+		s.layer = rand() % LAYERS;
+	}
+
+	printf("nucleos disponiveis: %u, %u sprites, %u camadas\n", std::thread::hardware_concurrency(), N, LAYERS);
+	measure<true>("com rotacao (matriz 2x3, sin/cos por sprite)", sprites);
+	measure<false>("sem rotacao (escala + translacao, sem trigonometria)", sprites);
+	return 0;
+}
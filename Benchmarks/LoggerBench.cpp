@@ -0,0 +1,123 @@
+/* Benchmark do logger assíncrono
+ * Custo por chamada no caminho quente, comparado com o que o jogo fazia (cout << ... << endl,
+ * que formata e força um flush a cada linha). A saída vai para um arquivo temporário nos dois
+ * casos, para não medir o terminal. Também mede 4 produtores ao mesmo tempo e o custo de uma
+ * chamada descartada pelo limite da categoria.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "Logger.h"
+#include "BenchUtil.h"
+
+const int CALLS = 200000;
+
+int main()
+{
+	printf("%28s %12s %12s\n", "", "ns/chamada", "descartados");
+
+	// O que o jogo fazia: formatação e flush síncronos
+	{
+		std::ofstream file("logger_bench_cout.txt");
+		double ms = bestOf(3, [&]() {
+			for (int i = 0; i < CALLS; i++)
+			{
+				file << "Score: " << i << std::endl;
+			}
+		});
+		printf("%28s %12.1f %12s\n", "ostream << endl", ms * 1e6 / CALLS, "-");
+	}
+
+	// Um produtor com o anel padrão em cache: rajadas de 4000 registros, esvaziadas entre uma e outra
+	{
+		FILE *out = tmpfile();
+		Logger logger(out);
+		uint16_t gameplay = logger.addCategory("gameplay");
+		double ms = 0.0;
+		for (int burst = 0; burst < CALLS / 4000; burst++)
+		{
+			ms += bestOf(1, [&]() {
+				for (int i = 0; i < 4000; i++)
+				{
+					logger.log(LOG_INFO, gameplay, "Score: {}", i);
+				}
+			});
+			logger.flush();
+		}
+		printf("%28s %12.1f %12llu\n", "Logger, rajadas em cache", ms * 1e6 / CALLS, (unsigned long long)logger.droppedCount());
+	}
+
+	// Um produtor; o anel comporta a rajada inteira, então nada é descartado
+	{
+		FILE *out = tmpfile();
+		Logger logger(out, 1 << 18);
+		uint16_t gameplay = logger.addCategory("gameplay");
+		double ms = bestOf(1, [&]() {
+			for (int i = 0; i < CALLS; i++)
+			{
+				logger.log(LOG_INFO, gameplay, "Score: {}", i);
+			}
+		});
+		logger.flush();
+		printf("%28s %12.1f %12llu\n", "Logger, rajada de 200k", ms * 1e6 / CALLS, (unsigned long long)logger.droppedCount());
+	}
+
+	// Quatro produtores disputando o mesmo anel
+	{
+		FILE *out = tmpfile();
+		Logger logger(out, 1 << 20);
+		uint16_t gameplay = logger.addCategory("gameplay");
+		BenchTimer timer;
+		std::vector<std::thread> producers;
+		for (int p = 0; p < 4; p++)
+		{
+			producers.emplace_back([&, p]() {
+				for (int i = 0; i < CALLS; i++)
+				{
+					logger.log(LOG_INFO, gameplay, "Vidas: {} (produtor {})", i, p);
+				}
+			});
+		}
+		for (std::thread &t : producers)
+		{
+			t.join();
+		}
+		double ms = timer.elapsedMs();
+		logger.flush();
+		printf("%28s %12.1f %12llu\n", "Logger, 4 produtores", ms * 1e6 / (4.0 * CALLS), (unsigned long long)logger.droppedCount());
+	}
+
+	// Categoria limitada: quase tudo é descartado logo na entrada
+	{
+		FILE *out = tmpfile();
+		Logger logger(out);
+		uint16_t limited = logger.addCategory("limitada", 100);
+		double ms = bestOf(1, [&]() {
+			for (int i = 0; i < CALLS; i++)
+			{
+				logger.log(LOG_INFO, limited, "colisao {}", i);
+			}
+		});
+		logger.flush();
+		printf("%28s %12.1f %12llu\n", "Logger, limite 100/s", ms * 1e6 / CALLS, (unsigned long long)logger.droppedCount());
+	}
+
+	// Nível abaixo do mínimo: só a comparação do nível
+	{
+		Logger logger(tmpfile());
+		double ms = bestOf(3, [&]() {
+			for (int i = 0; i < CALLS; i++)
+			{
+				logger.log(LOG_DEBUG, 0, "debug {}", i);
+			}
+		});
+		printf("%28s %12.1f %12s\n", "Logger, nivel filtrado", ms * 1e6 / CALLS, "-");
+	}
+
+	remove("logger_bench_cout.txt");
+	return 0;
+}
@@ -0,0 +1,183 @@
+/* Benchmark do fundo: a imagem inteira contra as camadas do parallax, sem janela
+ *   imagem   - o fundo antigo: background.png (2304x1296) num sprite do SpriteRenderer, escala 0.4
+ *   parallax - as quatro faixas da folha parallax.png (o original reduzido 3x) num ParallaxBackground,
+ *              com o personagem andando de um lado para o outro (cada camada rola no seu ritmo)
+ * As texturas são carregadas como no loadTexture do jogo (com mipmaps). Reporta a memória de
+ * textura na GPU (estimativa do GpuMemoryTracker), o tempo de carregar e enviar as texturas, os
+ * draws por frame e o tempo médio do frame com glFinish, também dividido pelos pixels cobertos: o
+ * sprite antigo deixava faixas da cor de fundo em cima e embaixo, o parallax cobre a tela inteira.
+ * No Linux sem display: tarefa "build parallax bench (EGL)" do tasks.json (rodar da pasta Benchmarks).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <stb_image.h>
+#include "HeadlessContext.h"
+#include "SpriteRenderer.h"
+#include "ParallaxBackground.h"
+#include "JobSystem.h"
+#include "RenderStats.h"
+#include "MemoryTracker.h"
+#include "BenchUtil.h"
+
+const int WIDTH = 800, HEIGHT = 600;
+const int FRAMES = 240;
+
+// As mesmas faixas do main do jogo
+const float LAYER_ROWS[] = { 0, 216, 999, 1236, 1296 }, LAYER_SCALE = HEIGHT / 1296.0f;
+const float LAYER_RATES[] = { 0.05f, 0.2f, 0.5f, 0.8f }, LAYER_DRIFTS[] = { 6.0f, 0.0f, 0.0f, 0.0f };
+
+// Como o loadTexture do jogo
+GLuint loadTexture(const std::string &path, int &width, int &height)
+{
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	int channels;
+	unsigned char *data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+	if (data == nullptr)
+	{
+		printf("Failed to load texture %s\n", path.c_str());
+	}
+	else
+	{
+		GLenum format = channels == 3 ? GL_RGB : GL_RGBA;
+		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+		glGenerateMipmap(GL_TEXTURE_2D);
+	}
+	stbi_image_free(data);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return texture;
+}
+
+struct Result
+{
+	double textureKB = 0.0, loadMs = 0.0, draws = 0.0, frameMs = 0.0, pixels = 0.0;
+
+	void print(const char *name) const
+	{
+		printf("%-10s %12.1f %10.2f %8.1f %10.3f %10.2f\n", name, textureKB, loadMs, draws, frameMs, frameMs * 1e6 / pixels);
+	}
+};
+
+// Scroll do personagem andando de uma borda à outra da tela, ida e volta
+float scrollAt(int frame)
+{
+	return 380.0f * std::sin(frame * 0.05f);
+}
+
+template <class Draw>
+void measureFrames(HeadlessContext &headless, Result &result, Draw drawFrame)
+{
+	for (int f = 0; f < FRAMES; f++)
+	{
+		BenchTimer frame;
+		beginRenderStats();
+		glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		drawFrame(f);
+		double cpuMs = frame.elapsedMs();
+		headless.finish();
+		const RenderStats &stats = endRenderStats(frame.elapsedMs(), cpuMs, 0.0);
+		result.draws += (double)stats.drawCalls / FRAMES;
+		result.frameMs += stats.frameMs / FRAMES;
+	}
+}
+
+Result runImage(HeadlessContext &headless, JobSystem &jobs, const glm::mat4 &projection)
+{
+	Result result;
+	int64_t before = gpuMemoryStats(GpuMemoryKind::Textures).bytes;
+	BenchTimer load;
+	int width, height;
+	GLuint texture = loadTexture("../Textures/Backgrounds/background.png", width, height);
+	headless.finish();
+	result.loadMs = load.elapsedMs();
+	result.textureKB = (gpuMemoryStats(GpuMemoryKind::Textures).bytes - before) / 1024.0;
+
+	SpriteRenderer renderer(1, 1);
+	renderer.init();
+	renderer.setProjection(glm::value_ptr(projection));
+	InstanceSprite background = {};
+	background.x = 400.0f;
+	background.y = 300.0f;
+	background.width = width * 0.4f;
+	background.height = height * 0.4f;
+	background.du = background.dv = 1.0f;
+	background.tint = 0xFFFFFFFFu;
+	result.pixels = std::min(background.width, (float)WIDTH) * std::min(background.height, (float)HEIGHT);
+	measureFrames(headless, result, [&](int) { renderer.draw(jobs, &background, 1, &texture); });
+
+	renderer.shutdown();
+	glDeleteTextures(1, &texture);
+	return result;
+}
+
+Result runParallax(HeadlessContext &headless, const glm::mat4 &projection)
+{
+	Result result;
+	int64_t before = gpuMemoryStats(GpuMemoryKind::Textures).bytes;
+	BenchTimer load;
+	int width, height;
+	GLuint sheet = loadTexture("../Textures/Backgrounds/parallax.png", width, height);
+	headless.finish();
+	result.loadMs = load.elapsedMs();
+	result.textureKB = (gpuMemoryStats(GpuMemoryKind::Textures).bytes - before) / 1024.0;
+
+	ParallaxBackground background;
+	background.init();
+	background.setProjection(glm::value_ptr(projection));
+	background.setSheet(sheet);
+	result.pixels = (double)WIDTH * HEIGHT;
+	for (uint32_t i = 0; i < MAX_PARALLAX_LAYERS; i++)
+	{
+		background.addLayer(LAYER_ROWS[i] / 1296, LAYER_ROWS[i + 1] / 1296, HEIGHT - LAYER_ROWS[i + 1] * LAYER_SCALE,
+							HEIGHT - LAYER_ROWS[i] * LAYER_SCALE, LAYER_RATES[i], LAYER_DRIFTS[i]);
+	}
+	measureFrames(headless, result, [&](int f) { background.draw(0.0f, WIDTH, scrollAt(f), f / 60.0f); });
+
+	background.shutdown();
+	glDeleteTextures(1, &sheet);
+	return result;
+}
+
+int main()
+{
+	HeadlessContext headless;
+	if (!headless.create(WIDTH, HEIGHT))
+	{
+		printf("sem contexto (%s): %s\n", HeadlessContext::backendName(), headless.error().c_str());
+		return 1;
+	}
+	installRenderStats();
+	installGpuMemoryTracking();
+	printf("backend: %s, %s, %d frames de %dx%d\n", HeadlessContext::backendName(), (const char *)glGetString(GL_RENDERER), FRAMES, WIDTH,
+		   HEIGHT);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glActiveTexture(GL_TEXTURE0);
+
+	JobSystem jobs(std::max(2u, std::thread::hardware_concurrency()));
+	glm::mat4 projection = glm::ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);
+
+	printf("%-10s %12s %10s %8s %10s %10s\n", "", "textura KB", "carga ms", "draws", "frame ms", "ns/pixel");
+	Result image = runImage(headless, jobs, projection);
+	Result parallax = runParallax(headless, projection);
+	image.print("imagem");
+	parallax.print("parallax");
+	printf("\nmemoria de textura %.1fx menor, carga %.1fx mais rapida\n", image.textureKB / parallax.textureKB, image.loadMs / parallax.loadMs);
+
+	headless.destroy();
+	return 0;
+}
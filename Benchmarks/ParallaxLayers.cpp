@@ -0,0 +1,88 @@
+/* Gera a folha de camadas do parallax a partir do fundo original
+ * O background.png (2304x1296) é uma imagem só, sem camadas separadas, e já emenda na horizontal.
+ * As camadas do jogo são faixas horizontais dela (céu, floresta, gelo e chão), cada uma rolando no
+ * seu ritmo com GL_REPEAT. Na tela o fundo fica com 600/1296 = 0.46 do tamanho original, então a
+ * folha é a imagem reduzida por média de blocos FACTOR x FACTOR: mais resolução não apareceria.
+ * Como a repetição depende da emenda, a diferença entre a última e a primeira coluna é comparada
+ * com a diferença média entre colunas vizinhas.
+ * Uso (rodar da pasta Benchmarks): ParallaxLayers; grava ../Textures/Backgrounds/parallax.png.
+ * Build: tarefa "build parallax layers" do tasks.json.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <stb_image.h>
+#include "PngWriter.h"
+
+const int FACTOR = 3;
+
+// Diferença média de cor entre as colunas a e b
+double columnDistance(const std::vector<uint8_t> &rgba, int width, int height, int a, int b)
+{
+	double sum = 0.0;
+	for (int y = 0; y < height; y++)
+	{
+		for (int c = 0; c < 3; c++)
+		{
+			sum += std::fabs((double)rgba[((size_t)y * width + a) * 4 + c] - rgba[((size_t)y * width + b) * 4 + c]);
+		}
+	}
+	return sum / (height * 3);
+}
+
+int main()
+{
+	int width, height, channels;
+	unsigned char *source = stbi_load("../Textures/Backgrounds/background.png", &width, &height, &channels, 4);
+	if (source == nullptr)
+	{
+		printf("Failed to load ../Textures/Backgrounds/background.png\n");
+		return 1;
+	}
+	if (width % FACTOR != 0 || height % FACTOR != 0)
+	{
+		printf("%dx%d nao divide por %d\n", width, height, FACTOR);
+		return 1;
+	}
+
+	const int outWidth = width / FACTOR, outHeight = height / FACTOR;
+	std::vector<uint8_t> out((size_t)outWidth * outHeight * 4);
+	for (int y = 0; y < outHeight; y++)
+	{
+		for (int x = 0; x < outWidth; x++)
+		{
+			for (int c = 0; c < 4; c++)
+			{
+				int sum = 0;
+				for (int sy = 0; sy < FACTOR; sy++)
+				{
+					for (int sx = 0; sx < FACTOR; sx++)
+					{
+						sum += source[((size_t)(y * FACTOR + sy) * width + x * FACTOR + sx) * 4 + c];
+					}
+				}
+				out[((size_t)y * outWidth + x) * 4 + c] = (uint8_t)((sum + FACTOR * FACTOR / 2) / (FACTOR * FACTOR));
+			}
+		}
+	}
+	stbi_image_free(source);
+
+	double neighbours = 0.0;
+	for (int x = 0; x + 1 < outWidth; x++)
+	{
+		neighbours += columnDistance(out, outWidth, outHeight, x, x + 1);
+	}
+	neighbours /= outWidth - 1;
+	printf("emenda %.2f, colunas vizinhas %.2f em media\n", columnDistance(out, outWidth, outHeight, outWidth - 1, 0), neighbours);
+
+	if (!writePng("../Textures/Backgrounds/parallax.png", out.data(), outWidth, outHeight))
+	{
+		printf("Failed to write ../Textures/Backgrounds/parallax.png\n");
+		return 1;
+	}
+	printf("%dx%d -> %dx%d: %.1f KB em RGBA, contra %.1f KB\n", width, height, outWidth, outHeight, out.size() / 1024.0,
+		   (double)width * height * 4 / 1024.0);
+	return 0;
+}
@@ -0,0 +1,90 @@
+/* Benchmark do profiler de CPU
+ * 1. Custo de uma zona: gravando, desligada em tempo de execução (setEnabled(false)) e sem
+ *    PROFILER_ENABLED (a macro não gera código; é o laço puro).
+ * 2. Quatro threads gravando enquanto a thread principal exporta o trace várias vezes.
+ * Compile com -DPROFILER_ENABLED para a primeira coluna medir a zona de fato.
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "Profiler.h"
+#include "BenchUtil.h"
+
+static thread_local uint64_t work = 0;
+
+// Corpo mínimo para a zona ter algo dentro
+static void body(uint64_t i)
+{
+	work += i * 2654435761u;
+	doNotOptimize(work);
+}
+
+int main()
+{
+	const int zones = 1000000;
+
+#ifndef PROFILER_ENABLED
+	printf("PROFILER_ENABLED indefinido: as zonas abaixo não geram código\n");
+#endif
+
+	// 1. Custo por zona
+	double baseline = bestOf(5, [&]() {
+		for (int i = 0; i < zones; i++)
+		{
+			body(i);
+		}
+	});
+	profiler.setEnabled(true);
+	double enabled = bestOf(5, [&]() {
+		for (int i = 0; i < zones; i++)
+		{
+			PROFILE_ZONE("zona");
+			body(i);
+		}
+	});
+	profiler.setEnabled(false);
+	double disabled = bestOf(5, [&]() {
+		for (int i = 0; i < zones; i++)
+		{
+			PROFILE_ZONE("zona");
+			body(i);
+		}
+	});
+	profiler.setEnabled(true);
+	printf("ns por zona: gravando %.1f, desligada %.1f (laço puro %.1f)\n", (enabled - baseline) * 1e6 / zones,
+		   (disabled - baseline) * 1e6 / zones, baseline * 1e6 / zones);
+
+	// 2. Exportar com as threads gravando
+	std::atomic<bool> running(true);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++)
+	{
+		threads.emplace_back([&running]() {
+			PROFILE_THREAD("worker");
+			while (running.load(std::memory_order_relaxed))
+			{
+				PROFILE_ZONE("externa");
+				for (int i = 0; i < 8; i++)
+				{
+					PROFILE_ZONE("interna");
+					body(i);
+				}
+			}
+		});
+	}
+	BenchTimer timer;
+	bool ok = true;
+	for (int d = 0; d < 5; d++)
+	{
+		ok = profiler.writeChromeTrace("profiler_bench_trace.json") && ok;
+	}
+	double dumpMs = timer.elapsedMs() / 5;
+	running.store(false);
+	for (std::thread &thread : threads)
+	{
+		thread.join();
+	}
+	printf("trace com 5 threads: %.2f ms por exportação (%s)\n", dumpMs, ok ? "profiler_bench_trace.json" : "falhou");
+	return 0;
+}
@@ -0,0 +1,134 @@
+/* Benchmark do scheduler de scripts (corrotinas)
+ * 1. Custo de resumir N scripts por tick (10^3 a 10^5), todos com waitNextTick.
+ * 2. O mesmo com esperas aleatórias de 2 a 120 ticks (passam pelo heap de timers).
+ * 3. Criar e terminar scripts curtos: frames do pool contra new/delete direto.
+ */
+
+#include <cstdlib>
+#include <vector>
+#include "ScriptScheduler.h"
+#include "BenchUtil.h"
+
+static uint64_t resumes = 0;
+
+static Script everyTick()
+{
+	for (;;)
+	{
+		resumes++;
+		co_await waitNextTick();
+	}
+}
+
+static Script randomWaits(uint32_t seed)
+{
+	for (;;)
+	{
+		resumes++;
+		seed = seed * 1664525u + 1013904223u;
+		co_await waitTicks(2 + (seed >> 16) % 119);
+	}
+}
+
+static Script oneShot(int *counter)
+{
+	(*counter)++;
+	co_return;
+}
+
+int main()
+{
+	const int ticks = 200;
+	printf("%10s %16s %16s\n", "scripts", "ns/resume tick", "ns/resume timer");
+	for (int n = 1000; n <= 100000; n *= 10)
+	{
+		double perTick, perTimer;
+		{
+			ScriptScheduler scheduler;
+			for (int i = 0; i < n; i++)
+			{
+				scheduler.spawn(everyTick());
+			}
+			scheduler.tick(); // primeira execução
+			resumes = 0;
+			double ms = bestOf(1, [&]() {
+				for (int t = 0; t < ticks; t++)
+				{
+					scheduler.tick();
+				}
+			});
+			perTick = ms * 1e6 / resumes;
+		}
+		{
+			ScriptScheduler scheduler;
+			for (int i = 0; i < n; i++)
+			{
+				scheduler.spawn(randomWaits(i));
+			}
+			scheduler.tick();
+			resumes = 0;
+			double ms = bestOf(1, [&]() {
+				for (int t = 0; t < ticks; t++)
+				{
+					scheduler.tick();
+				}
+			});
+			perTimer = ms * 1e6 / resumes;
+		}
+		printf("%10d %16.1f %16.1f\n", n, perTick, perTimer);
+	}
+
+	// 3. Frames: criar, rodar uma vez e destruir
+	{
+		const int scripts = 1000000;
+		int counter = 0;
+		ScriptScheduler scheduler;
+		double ms = bestOf(3, [&]() {
+			for (int i = 0; i < scripts; i += 1000)
+			{
+				for (int j = 0; j < 1000; j++)
+				{
+					scheduler.spawn(oneShot(&counter));
+				}
+				scheduler.tick();
+			}
+		});
+		printf("\nspawn + resume + destroy: %.1f ns por script (%d)\n", ms * 1e6 / scripts, counter / 3);
+
+		// Só a alocação do frame, no tamanho do frame de oneShot
+		const size_t frameSize = 64;
+		std::vector<void *> frames(1000);
+		double poolMs = bestOf(3, [&]() {
+			for (int i = 0; i < scripts; i += 1000)
+			{
+				for (int j = 0; j < 1000; j++)
+				{
+					frames[j] = scriptFrameAllocate(frameSize);
+				}
+				for (int j = 0; j < 1000; j++)
+				{
+					scriptFrameRelease(frames[j], frameSize);
+				}
+			}
+		});
+		double heapMs = bestOf(3, [&]() {
+			for (int i = 0; i < scripts; i += 1000)
+			{
+				for (int j = 0; j < 1000; j++)
+				{
+					frames[j] = ::operator new(frameSize);
+					doNotOptimize(frames[j]);
+				}
+				for (int j = 0; j < 1000; j++)
+				{
+					::operator delete(frames[j]);
+				}
+			}
+		});
+		printf("frame: pool %.1f ns, new/delete %.1f ns\n", poolMs * 1e6 / scripts, heapMs * 1e6 / scripts);
+		ScriptFrameStats stats = scriptFrameStats();
+		printf("pool: %llu frames vivos, %llu bytes reservados, %llu frames no heap\n", (unsigned long long)stats.inUse,
+			   (unsigned long long)stats.reservedBytes, (unsigned long long)stats.heapFrames);
+	}
+	return 0;
+}
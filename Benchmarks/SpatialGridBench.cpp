@@ -0,0 +1,64 @@
+/* Benchmark do broadphase por grade uniforme
+ * Reconstrói a grade e gera os pares candidatos a 1k/10k/100k entidades, com densidade
+ * constante (o mundo cresce com o número de entidades), e compara com a força bruta
+ * N x N do kernel SIMD. O narrowphase (overlaps) confirma que os pares batem.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "SpatialGrid.h"
+#include "BenchUtil.h"
+
+int main()
+{
+	const uint32_t counts[] = { 1000, 10000, 100000 };
+	printf("%8s %10s %10s %10s %12s %12s %14s\n", "N", "build ms", "pares ms", "ns/ent", "candidatos", "colisoes", "forca bruta ms");
+
+	for (uint32_t n : counts)
+	{
+		float world = std::sqrt((float)n) * 20.0f;
+		std::vector<float> minX(n), minY(n), maxX(n), maxY(n);
+		srand(11);
+		for (uint32_t i = 0; i < n; i++)
+		{
+			float x = world * (rand() / (float)RAND_MAX), y = world * (rand() / (float)RAND_MAX);
+			float h = 2.0f + (rand() % 5);
+			minX[i] = x - h;
+			maxX[i] = x + h;
+			minY[i] = y - h;
+			maxY[i] = y + h;
+		}
+		AABBColumns columns = { minX.data(), minY.data(), maxX.data(), maxY.data() };
+
+		SpatialGrid grid(16.0f, 0.0f, 0.0f, world, world);
+		std::vector<CandidatePair> pairs;
+		pairs.reserve(n * 4);
+
+		double buildMs = bestOf(5, [&]() { grid.build(columns, n); });
+		double pairsMs = bestOf(5, [&]() { grid.findPairs(pairs); });
+
+		uint32_t collisions = 0;
+		for (const CandidatePair &p : pairs)
+		{
+			AABB a = { minX[p.a], minY[p.a], maxX[p.a], maxY[p.a] };
+			AABB b = { minX[p.b], minY[p.b], maxX[p.b], maxY[p.b] };
+			collisions += overlaps(a, b) ? 1 : 0;
+		}
+
+		char brute[32] = "-";
+		if (n <= 10000)
+		{
+			std::vector<uint32_t> pa(1), pb(1);
+			uint32_t total = 0;
+			double bruteMs = bestOf(1, [&]() { total = overlapManyVsMany(columns, n, columns, n, pa.data(), pb.data(), 0); });
+			// A força bruta conta cada par duas vezes e cada caixa consigo mesma
+			uint32_t expected = (total - n) / 2;
+			snprintf(brute, sizeof(brute), "%.2f%s", bruteMs, expected == collisions ? "" : " (DIFERENTE)");
+		}
+
+		printf("%8u %10.3f %10.3f %10.1f %12zu %12u %14s\n", n, buildMs, pairsMs, (buildMs + pairsMs) * 1e6 / n, pairs.size(), collisions, brute);
+	}
+	return 0;
+}
@@ -0,0 +1,105 @@
+/* Benchmark do SpriteStore (SoA) contra o vector<Sprite> (AoS) original
+ * Mede itens atualizados por milissegundo no passo de movimento + AABB,
+ * que no jogo corresponde a updateItems() seguido de calculateAABB().
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glm/glm.hpp>
+#include "SpriteStore.h"
+#include "BenchUtil.h"
+
+using namespace glm;
+
+// Mesmo layout do Sprite do jogo antes do SoA
+struct Sprite
+{
+	float VAO, textureID;
+	vec3 pos, dimensions;
+	float angle;
+	int nAnimations, nFrames, iAnimation, iFrame;
+	float ds, dt;
+	float vel;
+	vec2 PMax, PMin;
+	int effect;
+};
+
+static void updateItemAoS(Sprite &sprite)
+{
+	if (sprite.pos.y > 50)
+	{
+		sprite.pos.y -= sprite.vel;
+	}
+	else
+	{
+		sprite.pos.y = 600;
+	}
+}
+
+static void calculateAABB(Sprite &sprite)
+{
+	sprite.PMin.x = sprite.pos.x - sprite.dimensions.x / 2.0;
+	sprite.PMin.y = sprite.pos.y - sprite.dimensions.y / 2.0;
+	sprite.PMax.x = sprite.pos.x + sprite.dimensions.x / 2.0;
+	sprite.PMax.y = sprite.pos.y + sprite.dimensions.y / 2.0;
+}
+
+int main()
+{
+	const uint32_t counts[] = { 1000, 100000, 1000000 };
+	printf("%10s %14s %14s %8s\n", "itens", "AoS itens/ms", "SoA itens/ms", "ganho");
+
+	for (uint32_t n : counts)
+	{
+		int frames = (int)(20000000 / n) + 1;
+
+		std::vector<Sprite> sprites(n);
+		SpriteStore store(n);
+		srand(7);
+		for (uint32_t i = 0; i < n; i++)
+		{
+			float x = (float)(rand() % 800), y = (float)(rand() % 600);
+			sprites[i].pos = vec3(x, y, 0);
+			sprites[i].dimensions = vec3(32, 32, 1);
+			sprites[i].vel = 0.1f + (rand() % 10) * 0.01f;
+
+			uint32_t d = store.denseIndex(store.spawn());
+			store.posX[d] = x;
+			store.posY[d] = y;
+			store.velY[d] = -sprites[i].vel;
+			store.halfW[d] = store.halfH[d] = 16;
+		}
+
+		double aosMs = bestOf(3, [&]() {
+			for (int f = 0; f < frames; f++)
+			{
+				for (uint32_t i = 0; i < n; i++)
+				{
+					updateItemAoS(sprites[i]);
+					calculateAABB(sprites[i]);
+				}
+			}
+			doNotOptimize(sprites[0]);
+		});
+
+		double soaMs = bestOf(3, [&]() {
+			for (int f = 0; f < frames; f++)
+			{
+				integrateMotion(store);
+				float *posY = store.posY.data();
+				for (uint32_t i = 0; i < n; i++)
+				{
+					posY[i] = posY[i] <= 50 ? 600.0f : posY[i];
+				}
+				buildAABBs(store);
+			}
+			doNotOptimize(store.minX[0]);
+		});
+
+		double aosRate = (double)n * frames / aosMs;
+		double soaRate = (double)n * frames / soaMs;
+		printf("%10u %14.0f %14.0f %7.1fx\n", n, aosRate, soaRate, soaRate / aosRate);
+	}
+	return 0;
+}
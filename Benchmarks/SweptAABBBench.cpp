@@ -0,0 +1,78 @@
+/* Benchmark da colisão contínua (swept AABB)
+ * 1. Tunelamento: itens rápidos caindo sobre o personagem; o teste discreto no fim de cada
+ *    tick perde contatos que o teste varrido encontra.
+ * 2. Custo: teste varrido do lote contra o teste discreto (build + overlap) do mesmo lote.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "SweptAABB.h"
+#include "BenchUtil.h"
+
+int main()
+{
+	printf("caminho SIMD compilado: %s\n\n", aabbKernelPath());
+
+	const uint32_t n = 100000;
+	std::vector<float> posX(n), posY(n), halfW(n), halfH(n), velX(n), velY(n);
+	std::vector<float> minX(n), minY(n), maxX(n), maxY(n);
+	std::vector<uint32_t> hits(n);
+	std::vector<float> times(n);
+
+	// Personagem de 48x64 em (400, 100), como no jogo
+	AABB character = { 376.0f, 68.0f, 424.0f, 132.0f };
+
+	srand(5);
+	for (uint32_t i = 0; i < n; i++)
+	{
+		posX[i] = 300.0f + (rand() % 200);
+		posY[i] = 140.0f + (rand() % 300);
+		halfW[i] = halfH[i] = 8.0f;
+		velX[i] = 0.0f;
+		velY[i] = -(60.0f + (rand() % 200)); // bem mais que a altura do personagem por tick
+	}
+	SweptBatch batch = { posX.data(), posY.data(), halfW.data(), halfH.data(), velX.data(), velY.data() };
+
+	// Contatos no tick: discreto (posição final) x varrido (segmento inteiro)
+	std::vector<float> endY(n);
+	for (uint32_t i = 0; i < n; i++)
+	{
+		endY[i] = posY[i] + velY[i];
+	}
+	buildAABBBatch(posX.data(), endY.data(), halfW.data(), halfH.data(), minX.data(), minY.data(), maxX.data(), maxY.data(), n);
+	AABBColumns endBoxes = { minX.data(), minY.data(), maxX.data(), maxY.data() };
+	uint32_t discrete = overlapOneVsManyIndices(character, endBoxes, n, hits.data());
+	uint32_t swept = sweepAgainstBox(character, 0.0f, 0.0f, batch, n, hits.data(), times.data());
+	SweptHit first = earliestHit(hits.data(), times.data(), swept);
+
+	uint32_t reference = 0;
+	for (uint32_t i = 0; i < n; i++)
+	{
+		float t;
+		reference += sweptTOI(character, 0.0f, 0.0f, posX[i], posY[i], halfW[i], halfH[i], velX[i], velY[i], t) ? 1 : 0;
+	}
+	printf("contatos no tick: discreto %u, varrido %u (escalar %u), primeiro contato item %u em t = %.3f\n\n",
+		   discrete, swept, reference, first.index, first.toi);
+
+	const int frames = 200;
+	uint32_t sink = 0;
+	double discreteMs = bestOf(3, [&]() {
+		for (int f = 0; f < frames; f++)
+		{
+			buildAABBBatch(posX.data(), posY.data(), halfW.data(), halfH.data(), minX.data(), minY.data(), maxX.data(), maxY.data(), n);
+			sink += overlapOneVsManyIndices(character, endBoxes, n, hits.data());
+		}
+		doNotOptimize(sink);
+	});
+	double sweptMs = bestOf(3, [&]() {
+		for (int f = 0; f < frames; f++)
+		{
+			sink += sweepAgainstBox(character, 0.0f, 0.0f, batch, n, hits.data(), times.data());
+		}
+		doNotOptimize(sink);
+	});
+	printf("%u itens: discreto %.3f ms/frame, varrido %.3f ms/frame (%.2fx)\n", n, discreteMs / frames, sweptMs / frames, sweptMs / discreteMs);
+	return swept == reference ? 0 : 1;
+}
@@ -0,0 +1,85 @@
+/* Benchmark da telemetria por frame
+ * Simula uma sessão de 10 minutos a 60 Hz (36000 frames e um evento a cada segundo) e mede o
+ * custo de recordFrame/recordEvent na thread que grava, com a thread de escrita rodando ao lado.
+ * Os frames vão em lotes de 10 s de jogo, com uma pausa entre eles para a escrita alcançar (como
+ * no jogo, em que a thread de fundo tem o frame inteiro): só o tempo das chamadas é somado.
+ * O custo é comparado com o frame de 16.7 ms; a meta é ficar bem abaixo de 1%.
+ * Depois converte o arquivo para CSV e confere o número de linhas.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include "Telemetry.h"
+#include "BenchUtil.h"
+
+const uint32_t FRAMES = 36000;
+const uint32_t FRAMES_PER_BURST = 600;
+const double FRAME_MS = 1000.0 / 60.0;
+
+int main()
+{
+	Telemetry telemetry;
+	if (!telemetry.start("telemetry_bench.bin"))
+	{
+		printf("nao abriu telemetry_bench.bin\n");
+		return 1;
+	}
+
+	TelemetryRecord frame = {};
+	double frameCallsMs = 0.0, eventCallsMs = 0.0;
+	uint32_t eventCount = 0;
+	for (uint32_t first = 0; first < FRAMES; first += FRAMES_PER_BURST)
+	{
+		BenchTimer timer;
+		for (uint32_t f = first; f < first + FRAMES_PER_BURST; f++)
+		{
+			frame.frameMs = 16.6f + (f % 7) * 0.01f;
+			frame.simMs = 1.2f;
+			frame.renderMs = 3.4f;
+			frame.drawCalls = 4;
+			frame.instances = 60 + f % 20;
+			frame.entities = frame.instances;
+			telemetry.recordFrame(frame);
+		}
+		frameCallsMs += timer.elapsedMs();
+
+		BenchTimer eventTimer;
+		for (uint32_t e = 0; e < FRAMES_PER_BURST / 60; e++)
+		{
+			telemetry.recordEvent(TELEMETRY_SCORE, (int32_t)eventCount++);
+		}
+		eventCallsMs += eventTimer.elapsedMs();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+	BenchTimer stopTimer;
+	telemetry.stop();
+	double stopMs = stopTimer.elapsedMs();
+
+	double nsPerFrame = frameCallsMs * 1e6 / FRAMES;
+	double nsPerEvent = eventCallsMs * 1e6 / eventCount;
+	printf("recordFrame: %.1f ns/chamada (%.5f%% de um frame de %.1f ms)\n", nsPerFrame, nsPerFrame * 1e-6 / FRAME_MS * 100.0, FRAME_MS);
+	printf("recordEvent: %.1f ns/chamada\n", nsPerEvent);
+	printf("gravados %llu, descartados %llu, stop %.2f ms\n", (unsigned long long)telemetry.recordCount(),
+		   (unsigned long long)telemetry.droppedCount(), stopMs);
+
+	BenchTimer convertTimer;
+	if (!telemetryToCsv("telemetry_bench.bin", "telemetry_bench.csv"))
+	{
+		printf("falha na conversao\n");
+		return 1;
+	}
+	double convertMs = convertTimer.elapsedMs();
+	FILE *csv = fopen("telemetry_bench.csv", "r");
+	uint32_t lines = 0;
+	for (int c; (c = fgetc(csv)) != EOF;)
+	{
+		lines += c == '\n';
+	}
+	fclose(csv);
+	printf("csv: %u linhas de dados (esperado %u), conversao %.1f ms\n", lines - 1, FRAMES + eventCount, convertMs);
+	remove("telemetry_bench.bin");
+	remove("telemetry_bench.csv");
+	return lines - 1 == FRAMES + eventCount ? 0 : 1;
+}
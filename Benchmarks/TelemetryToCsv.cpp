@@ -0,0 +1,35 @@
+/* Converte um arquivo de telemetria (F5 no jogo grava telemetry.bin) para CSV
+ * Uso: TelemetryToCsv entrada.bin [saida.csv]; sem a saída, troca a extensão por .csv.
+ * Compila com a tarefa de benchmark do tasks.json (Telemetry.cpp já está na lista).
+ */
+
+#include <cstdio>
+#include <string>
+#include "Telemetry.h"
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		printf("uso: %s entrada.bin [saida.csv]\n", argv[0]);
+		return 1;
+	}
+	std::string output;
+	if (argc >= 3)
+	{
+		output = argv[2];
+	}
+	else
+	{
+		output = argv[1];
+		size_t dot = output.find_last_of('.');
+		output = (dot == std::string::npos ? output : output.substr(0, dot)) + ".csv";
+	}
+	if (!telemetryToCsv(argv[1], output.c_str()))
+	{
+		printf("falha ao converter %s (arquivo ausente, de outra versao ou sem permissao de escrita)\n", argv[1]);
+		return 1;
+	}
+	printf("%s -> %s\n", argv[1], output.c_str());
+	return 0;
+}
@@ -0,0 +1,279 @@
+/* Benchmark do TileMap sem janela
+ * Mapas de uma camada cheia, de 64x64 a 4096x4096 tiles de 32 pixels, atravessados na diagonal por
+ * uma câmera de 800x600 que anda 12 pixels por frame. Cada chunk é enviado na primeira vez que
+ * aparece; depois disso o frame só faz os draws dos chunks na tela. Reporta draws por frame (média e
+ * máximo), tempo de CPU e do frame inteiro (com glFinish), KB enviados por frame e chunks refeitos.
+ * Duas comparações no mapa de 512x512:
+ *   por tile - o que seria montar o nível com um sprite por tile: um draw por tile visível, com a
+ *              posição e a célula do atlas em uniforms
+ *   edicao   - um setTile por frame num tile visível, que refaz um chunk por frame
+ * No Linux sem display: tarefa "build tilemap bench (EGL)" do tasks.json.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glad/glad.h>
+#include "HeadlessContext.h"
+#include "TileMap.h"
+#include "RenderStats.h"
+#include "BenchUtil.h"
+
+const int WIDTH = 800, HEIGHT = 600;
+const float TILE_SIZE = 32.0f, SPEED = 12.0f;
+const uint32_t ATLAS_CELLS = 4, CELL_PIXELS = 16;
+const int FRAMES = 240;
+
+// Atlas 4x4 com uma cor por célula e borda escura, para os tiles se distinguirem
+GLuint makeAtlas()
+{
+	const uint32_t size = ATLAS_CELLS * CELL_PIXELS;
+	std::vector<uint8_t> pixels(size * size * 4);
+	for (uint32_t y = 0; y < size; y++)
+	{
+		for (uint32_t x = 0; x < size; x++)
+		{
+			uint32_t cell = (y / CELL_PIXELS) * ATLAS_CELLS + x / CELL_PIXELS;
+			bool border = x % CELL_PIXELS == 0 || y % CELL_PIXELS == 0;
+			uint8_t *p = &pixels[(y * size + x) * 4];
+			p[0] = border ? 40 : (uint8_t)(60 + cell * 12);
+			p[1] = border ? 30 : (uint8_t)(200 - cell * 10);
+			p[2] = border ? 30 : (uint8_t)(90 + (cell % 4) * 40);
+			p[3] = 255;
+		}
+	}
+	GLuint texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return texture;
+}
+
+uint16_t tileAt(uint32_t x, uint32_t y)
+{
+	return (uint16_t)(1 + (x * 7 + y * 13) % (ATLAS_CELLS * ATLAS_CELLS));
+}
+
+void fillMap(TileMap &map)
+{
+	for (uint32_t y = 0; y < map.height(); y++)
+	{
+		for (uint32_t x = 0; x < map.width(); x++)
+		{
+			map.setTile(0, x, y, tileAt(x, y));
+		}
+	}
+}
+
+// Projeção ortográfica de uma janela 800x600 com o canto inferior esquerdo em (x, y)
+void cameraProjection(float x, float y, float *m)
+{
+	const float values[16] = {
+		2.0f / WIDTH, 0.0f, 0.0f, 0.0f,
+		0.0f, 2.0f / HEIGHT, 0.0f, 0.0f,
+		0.0f, 0.0f, -1.0f, 0.0f,
+		-1.0f - 2.0f * x / WIDTH, -1.0f - 2.0f * y / HEIGHT, 0.0f, 1.0f };
+	std::copy(values, values + 16, m);
+}
+
+struct Totals
+{
+	double cpuMs = 0.0, frameMs = 0.0;
+	uint64_t draws = 0, bytes = 0;
+	uint32_t maxDraws = 0;
+
+	void add(const RenderStats &stats)
+	{
+		cpuMs += stats.cpuMs;
+		frameMs += stats.frameMs;
+		draws += stats.drawCalls;
+		bytes += stats.bytesUploaded;
+		maxDraws = std::max(maxDraws, stats.drawCalls);
+	}
+
+	void print(const char *name, uint64_t tiles, uint32_t rebuilds) const
+	{
+		printf("%-12s %10llu %8.1f %6u %10.3f %10.3f %10.1f %8u\n", name, (unsigned long long)tiles, (double)draws / FRAMES, maxDraws,
+			   cpuMs / FRAMES, frameMs / FRAMES, bytes / 1024.0 / FRAMES, rebuilds);
+	}
+};
+
+// Rola a câmera e chama drawFrame(x, y) em cada frame; edit(frame, x, y) roda antes do desenho
+template <class Draw, class Edit>
+Totals scroll(HeadlessContext &headless, float mapPixels, Draw drawFrame, Edit edit)
+{
+	Totals totals;
+	for (int f = 0; f < FRAMES; f++)
+	{
+		float x = std::min(f * SPEED, std::max(0.0f, mapPixels - WIDTH));
+		float y = std::min(f * SPEED, std::max(0.0f, mapPixels - HEIGHT));
+		BenchTimer frame;
+		beginRenderStats();
+		edit(f, x, y);
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
+		drawFrame(x, y);
+		double cpuMs = frame.elapsedMs();
+		headless.finish();
+		totals.add(endRenderStats(frame.elapsedMs(), cpuMs, 0.0));
+	}
+	return totals;
+}
+
+Totals runChunked(HeadlessContext &headless, GLuint atlas, uint32_t tiles, bool editing, uint32_t &rebuilds)
+{
+	TileMap map(tiles, tiles, 1, TILE_SIZE);
+	if (!map.init())
+	{
+		return Totals();
+	}
+	map.setAtlas(atlas, ATLAS_CELLS, ATLAS_CELLS);
+	fillMap(map);
+
+	float projection[16];
+	auto drawFrame = [&](float x, float y) {
+		cameraProjection(x, y, projection);
+		map.setProjection(projection);
+		map.draw(x, y, x + WIDTH, y + HEIGHT);
+	};
+	if (editing)
+	{
+		// Os chunks da tela já enviados: só a edição reenvia
+		scroll(headless, tiles * TILE_SIZE, drawFrame, [](int, float, float) {});
+	}
+	uint32_t before = map.rebuildCount();
+	Totals totals = scroll(headless, tiles * TILE_SIZE, drawFrame, [&](int f, float x, float y) {
+		if (editing)
+		{
+			uint32_t tx = (uint32_t)(x / TILE_SIZE) + f % 20, ty = (uint32_t)(y / TILE_SIZE) + f % 15;
+			map.setTile(0, tx, ty, (uint16_t)(1 + (map.tile(0, tx, ty) % (ATLAS_CELLS * ATLAS_CELLS))));
+		}
+	});
+	rebuilds = map.rebuildCount() - before;
+	map.shutdown();
+	return totals;
+}
+
+// Um draw por tile visível: o nível montado com um sprite por tile
+Totals runPerTile(HeadlessContext &headless, GLuint atlas, uint32_t tiles)
+{
+	const GLchar *vertexSource = R"(
+		#version 400
+		layout (location = 0) in vec2 corner;	// 0..1
+		uniform mat4 projection;
+		uniform vec4 rect;	// x, y, largura, altura
+		uniform vec4 cell;	// u0, v0, du, dv
+		out vec2 textureCoord;
+		void main() {
+			gl_Position = projection * vec4( rect.xy + corner * rect.zw , 0.0 , 1.0 );
+			textureCoord = vec2( cell.x + corner.x * cell.z , cell.y + (1.0 - corner.y) * cell.w );
+		}
+	)";
+	const GLchar *fragmentSource = R"(
+		#version 400
+		in vec2 textureCoord;
+		uniform sampler2D textureBuffer;
+		out vec4 color;
+		void main() { color = texture(textureBuffer,textureCoord); }
+	)";
+	GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER), fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+	glShaderSource(vertexShader, 1, &vertexSource, NULL);
+	glCompileShader(vertexShader);
+	glShaderSource(fragmentShader, 1, &fragmentSource, NULL);
+	glCompileShader(fragmentShader);
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+	GLint projectionLocation = glGetUniformLocation(program, "projection");
+	GLint rectLocation = glGetUniformLocation(program, "rect");
+	GLint cellLocation = glGetUniformLocation(program, "cell");
+
+	const GLfloat corners[] = { 0, 0, 1, 0, 0, 1, 1, 1 };
+	GLuint vao, vbo;
+	glGenVertexArrays(1, &vao);
+	glGenBuffers(1, &vbo);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid *)0);
+	glEnableVertexAttribArray(0);
+	glBindVertexArray(0);
+
+	std::vector<uint16_t> map((size_t)tiles * tiles);
+	for (uint32_t y = 0; y < tiles; y++)
+	{
+		for (uint32_t x = 0; x < tiles; x++)
+		{
+			map[(size_t)y * tiles + x] = tileAt(x, y);
+		}
+	}
+
+	float projection[16];
+	const float cellSize = 1.0f / ATLAS_CELLS;
+	Totals totals = scroll(headless, tiles * TILE_SIZE, [&](float x, float y) {
+		cameraProjection(x, y, projection);
+		glUseProgram(program);
+		glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, projection);
+		glBindTexture(GL_TEXTURE_2D, atlas);
+		glBindVertexArray(vao);
+		uint32_t x0 = (uint32_t)(x / TILE_SIZE), y0 = (uint32_t)(y / TILE_SIZE);
+		uint32_t x1 = std::min(tiles - 1, (uint32_t)((x + WIDTH) / TILE_SIZE));
+		uint32_t y1 = std::min(tiles - 1, (uint32_t)((y + HEIGHT) / TILE_SIZE));
+		for (uint32_t ty = y0; ty <= y1; ty++)
+		{
+			for (uint32_t tx = x0; tx <= x1; tx++)
+			{
+				uint32_t c = map[(size_t)ty * tiles + tx] - 1u;
+				glUniform4f(rectLocation, tx * TILE_SIZE, ty * TILE_SIZE, TILE_SIZE, TILE_SIZE);
+				glUniform4f(cellLocation, (c % ATLAS_CELLS) * cellSize, (c / ATLAS_CELLS) * cellSize, cellSize, cellSize);
+				glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+			}
+		}
+		glBindVertexArray(0);
+	}, [](int, float, float) {});
+
+	glDeleteVertexArrays(1, &vao);
+	glDeleteBuffers(1, &vbo);
+	glDeleteProgram(program);
+	return totals;
+}
+
+int main()
+{
+	HeadlessContext headless;
+	if (!headless.create(WIDTH, HEIGHT))
+	{
+		printf("sem contexto (%s): %s\n", HeadlessContext::backendName(), headless.error().c_str());
+		return 1;
+	}
+	installRenderStats();
+	printf("backend: %s, %s, chunks de %ux%u tiles, %d frames\n", HeadlessContext::backendName(), (const char *)glGetString(GL_RENDERER),
+		   TILE_CHUNK_SIZE, TILE_CHUNK_SIZE, FRAMES);
+	glActiveTexture(GL_TEXTURE0);
+	GLuint atlas = makeAtlas();
+
+	printf("%-12s %10s %8s %6s %10s %10s %10s %8s\n", "", "tiles", "draws", "max", "cpu ms", "frame ms", "KB/frame", "rebuilds");
+	const uint32_t sizes[] = { 64, 512, 4096 };
+	for (uint32_t tiles : sizes)
+	{
+		uint32_t rebuilds = 0;
+		Totals totals = runChunked(headless, atlas, tiles, false, rebuilds);
+		char name[32];
+		snprintf(name, sizeof(name), "chunks %u", tiles);
+		totals.print(name, (uint64_t)tiles * tiles, rebuilds);
+	}
+	runPerTile(headless, atlas, 512).print("por tile 512", 512ull * 512, 0);
+	uint32_t rebuilds = 0;
+	runChunked(headless, atlas, 512, true, rebuilds).print("edicao 512", 512ull * 512, rebuilds);
+
+	glDeleteTextures(1, &atlas);
+	headless.destroy();
+	return 0;
+}
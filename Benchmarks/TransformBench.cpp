@@ -0,0 +1,248 @@
+/* Benchmark da montagem da matriz de modelo de um sprite
+ * O drawSprite dos exemplos monta a matriz com translate(mat4(1), pos), rotate(radians(angle), z) e
+ * scale(dimensions): três produtos 4x4 completos mais seno e cosseno, mesmo com angle = 0, que é o
+ * caso de todos os sprites do jogo. Alternativas medidas, 100k sprites cada:
+ *   glm           - o caminho do drawSprite
+ *   glm SIMD      - o mesmo código com os tipos alinhados da glm (SSE2 nos produtos de vec4)
+ *   afim 2D       - escreve a matriz direto: base 2x2 (rotação * escala) e translação
+ *   sin/cos prontos - idem, com seno e cosseno calculados quando o ângulo muda, não por frame
+ *   so colunas    - a saída já tem as partes constantes; escreve só x e y das colunas 0, 1 e 3
+ *   instancia     - writeInstance com rotação (SpriteInstance<true>: base 2x2 + translação + UV + tint)
+ *   instancia 2D  - writeInstance sem rotação (SpriteInstance<false>, o que o jogo usa): só no
+ *                   cenário de ângulo 0, já que o tipo ignora o ângulo
+ * Dois cenários: todos com ângulo 0 (o jogo) e ângulos aleatórios. Cada variante é comparada
+ * com a matriz da glm.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_aligned.hpp>
+#include "InstanceBuilder.h"
+#include "BenchUtil.h"
+
+const uint32_t N = 100000;
+const int RUNS = 20;
+
+// Tipos alinhados: com SSE2 disponível, a glm usa intrínsecos nas operações de vec4 deles
+typedef glm::tmat4x4<float, glm::aligned_highp> simd_mat4;
+typedef glm::tvec3<float, glm::aligned_highp> simd_vec3;
+
+// Os campos do Sprite que entram na matriz
+struct SpriteTransform
+{
+	glm::vec3 pos;
+	glm::vec3 dimensions;
+	float angle; // graus, como no Sprite
+};
+
+struct Scene
+{
+	std::vector<SpriteTransform> sprites;
+	std::vector<float> cosines, sines;		// sin/cos prontos: atualizados só quando o ângulo muda
+	std::vector<InstanceSprite> instances;	// a mesma cena na entrada do InstanceBuilder
+};
+
+Scene makeScene(bool rotated)
+{
+	Scene scene;
+	srand(7);
+	for (uint32_t i = 0; i < N; i++)
+	{
+		SpriteTransform s;
+		s.pos = glm::vec3((float)(rand() % 800), (float)(rand() % 600), 0.0f);
+		s.dimensions = glm::vec3(16.0f + rand() % 48, 16.0f + rand() % 48, 1.0f);
+		s.angle = rotated ? (float)(rand() % 360) : 0.0f;
+		scene.sprites.push_back(s);
+		scene.cosines.push_back(std::cos(glm::radians(s.angle)));
+		scene.sines.push_back(std::sin(glm::radians(s.angle)));
+
+		InstanceSprite instance = {};
+		instance.x = s.pos.x;
+		instance.y = s.pos.y;
+		instance.width = s.dimensions.x;
+		instance.height = s.dimensions.y;
+		instance.angle = glm::radians(s.angle);
+		instance.du = instance.dv = 1.0f;
+		instance.tint = 0xFFFFFFFFu;
+		scene.instances.push_back(instance);
+	}
+	return scene;
+}
+
+// Base 2x2 (rotação * escala) e translação; z segue como no scale/translate da glm
+inline void writeAffine(const SpriteTransform &s, float c, float sn, float *m)
+{
+	m[0] = c * s.dimensions.x;
+	m[1] = sn * s.dimensions.x;
+	m[2] = 0.0f;
+	m[3] = 0.0f;
+	m[4] = -sn * s.dimensions.y;
+	m[5] = c * s.dimensions.y;
+	m[6] = 0.0f;
+	m[7] = 0.0f;
+	m[8] = 0.0f;
+	m[9] = 0.0f;
+	m[10] = s.dimensions.z;
+	m[11] = 0.0f;
+	m[12] = s.pos.x;
+	m[13] = s.pos.y;
+	m[14] = s.pos.z;
+	m[15] = 1.0f;
+}
+
+bool sameMatrices(const std::vector<glm::mat4> &expected, const float *actual, size_t stride)
+{
+	for (uint32_t i = 0; i < N; i++)
+	{
+		const float *e = &expected[i][0][0];
+		const float *a = actual + i * stride;
+		for (int k = 0; k < 16; k++)
+		{
+			if (std::fabs(e[k] - a[k]) > 1e-4f * (1.0f + std::fabs(e[k])))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+void run(const char *title, bool rotated)
+{
+	Scene scene = makeScene(rotated);
+	const std::vector<SpriteTransform> &sprites = scene.sprites;
+	std::vector<glm::mat4> expected(N), out(N);
+	std::vector<simd_mat4> outSimd(N);
+	std::vector<SpriteInstance<true>> outInstances(N);
+	std::vector<SpriteInstance<false>> outInstances2D(N);
+
+	printf("%s\n", title);
+	printf("%18s %10s %10s %10s\n", "", "ms", "ns/sprite", "confere");
+
+	auto report = [](const char *name, double ms, const char *check) {
+		printf("%18s %10.3f %10.2f %10s\n", name, ms, ms * 1e6 / N, check);
+	};
+
+	double ms = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			const SpriteTransform &s = sprites[i];
+			glm::mat4 model = glm::translate(glm::mat4(1.0f), s.pos);
+			model = glm::rotate(model, glm::radians(s.angle), glm::vec3(0.0f, 0.0f, 1.0f));
+			expected[i] = glm::scale(model, s.dimensions);
+		}
+		doNotOptimize(expected[0]);
+	});
+	report("glm", ms, "-");
+
+	ms = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			const SpriteTransform &s = sprites[i];
+			simd_mat4 model = glm::translate(simd_mat4(1.0f), simd_vec3(s.pos));
+			model = glm::rotate(model, glm::radians(s.angle), simd_vec3(0.0f, 0.0f, 1.0f));
+			outSimd[i] = glm::scale(model, simd_vec3(s.dimensions));
+		}
+		doNotOptimize(outSimd[0]);
+	});
+	report("glm SIMD", ms, sameMatrices(expected, &outSimd[0][0][0], 16) ? "ok" : "DIFERENTE");
+
+	ms = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			float radians = glm::radians(sprites[i].angle);
+			writeAffine(sprites[i], std::cos(radians), std::sin(radians), &out[i][0][0]);
+		}
+		doNotOptimize(out[0]);
+	});
+	report("afim 2D", ms, sameMatrices(expected, &out[0][0][0], 16) ? "ok" : "DIFERENTE");
+
+	ms = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			writeAffine(sprites[i], scene.cosines[i], scene.sines[i], &out[i][0][0]);
+		}
+		doNotOptimize(out[0]);
+	});
+	report("sin/cos prontos", ms, sameMatrices(expected, &out[0][0][0], 16) ? "ok" : "DIFERENTE");
+
+	// Partes constantes (z, linha de baixo) escritas uma vez fora da medida
+	for (uint32_t i = 0; i < N; i++)
+	{
+		writeAffine(sprites[i], 1.0f, 0.0f, &out[i][0][0]);
+	}
+	ms = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			const SpriteTransform &s = sprites[i];
+			float c = scene.cosines[i], sn = scene.sines[i];
+			float *m = &out[i][0][0];
+			m[0] = c * s.dimensions.x;
+			m[1] = sn * s.dimensions.x;
+			m[4] = -sn * s.dimensions.y;
+			m[5] = c * s.dimensions.y;
+			m[12] = s.pos.x;
+			m[13] = s.pos.y;
+		}
+		doNotOptimize(out[0]);
+	});
+	report("so colunas", ms, sameMatrices(expected, &out[0][0][0], 16) ? "ok" : "DIFERENTE");
+
+	ms = bestOf(RUNS, [&]() {
+		for (uint32_t i = 0; i < N; i++)
+		{
+			writeInstance(scene.instances[i], outInstances[i]);
+		}
+		doNotOptimize(outInstances[0]);
+	});
+	// A instância não tem matriz 4x4: confere a base e a translação contra a glm
+	bool same = true;
+	for (uint32_t i = 0; i < N && same; i++)
+	{
+		const float *e = &expected[i][0][0];
+		const Transform2D<true> &a = outInstances[i].transform;
+		const float pairs[6][2] = {{e[0], a.basis[0]}, {e[1], a.basis[1]}, {e[4], a.basis[2]}, {e[5], a.basis[3]}, {e[12], a.translation[0]}, {e[13], a.translation[1]}};
+		for (const auto &p : pairs)
+		{
+			same = same && std::fabs(p[0] - p[1]) <= 1e-4f * (1.0f + std::fabs(p[0]));
+		}
+	}
+	report("instancia", ms, same ? "ok" : "DIFERENTE");
+
+	if (!rotated)
+	{
+		ms = bestOf(RUNS, [&]() {
+			for (uint32_t i = 0; i < N; i++)
+			{
+				writeInstance(scene.instances[i], outInstances2D[i]);
+			}
+			doNotOptimize(outInstances2D[0]);
+		});
+		// Sem rotação a base é diagonal: a escala fica nos elementos 0 e 5 da matriz
+		same = true;
+		for (uint32_t i = 0; i < N && same; i++)
+		{
+			const float *e = &expected[i][0][0];
+			const Transform2D<false> &a = outInstances2D[i].transform;
+			const float pairs[4][2] = {{e[0], a.scale[0]}, {e[5], a.scale[1]}, {e[12], a.translation[0]}, {e[13], a.translation[1]}};
+			for (const auto &p : pairs)
+			{
+				same = same && std::fabs(p[0] - p[1]) <= 1e-4f * (1.0f + std::fabs(p[0]));
+			}
+		}
+		report("instancia 2D", ms, same ? "ok" : "DIFERENTE");
+	}
+	printf("\n");
+}
+
+int main()
+{
+	printf("%u sprites, melhor de %d\n\n", N, RUNS);
+	run("angulo 0 (todos os sprites do jogo)", false);
+	run("angulos aleatorios", true);
+	return 0;
+}
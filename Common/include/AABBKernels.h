@@ -0,0 +1,50 @@
+// Kernels vetorizados de AABB (Axis Aligned Bounding Box) sobre lotes SoA
+// O caminho é escolhido em tempo de compilação: AVX2 (8 caixas por instrução, com
+// /arch:AVX2 ou -mavx2), SSE (4 caixas, padrão em x64) ou escalar. Defina
+// AABB_KERNELS_SCALAR para forçar o caminho escalar.
+// A sobreposição é inclusiva (>=), igual ao checkCollision original.
+
+#pragma once
+
+#include <cstdint>
+
+struct AABB
+{
+	float minX, minY, maxX, maxY;
+};
+
+// Visão somente leitura de colunas de AABB (por exemplo as do SpriteStore)
+struct AABBColumns
+{
+	const float *minX, *minY, *maxX, *maxY;
+};
+
+// Nome do caminho compilado: "AVX2", "SSE" ou "escalar"
+const char *aabbKernelPath();
+
+// min = pos - half, max = pos + half para count entidades
+void buildAABBBatch(const float *posX, const float *posY, const float *halfW, const float *halfH,
+					float *minX, float *minY, float *maxX, float *maxY, uint32_t count);
+
+// Testa box contra count caixas. mask recebe 1 bit por caixa em palavras de 64 bits
+// ((count + 63) / 64 palavras). Retorna o número de caixas sobrepostas.
+uint32_t overlapOneVsMany(AABB box, AABBColumns boxes, uint32_t count, uint64_t *mask);
+
+// Igual ao anterior, mas grava em hits os índices sobrepostos, em ordem crescente.
+// hits precisa de espaço para count índices.
+uint32_t overlapOneVsManyIndices(AABB box, AABBColumns boxes, uint32_t count, uint32_t *hits);
+
+// Todos os pares (a, b) sobrepostos entre dois lotes, até maxPairs.
+// Retorna o número total de pares encontrados (pode passar de maxPairs).
+uint32_t overlapManyVsMany(AABBColumns a, uint32_t countA, AABBColumns b, uint32_t countB,
+						   uint32_t *pairsA, uint32_t *pairsB, uint32_t maxPairs);
+
+// Versões escalares de referência, sempre disponíveis
+void buildAABBBatchScalar(const float *posX, const float *posY, const float *halfW, const float *halfH,
+						  float *minX, float *minY, float *maxX, float *maxY, uint32_t count);
+uint32_t overlapOneVsManyIndicesScalar(AABB box, AABBColumns boxes, uint32_t count, uint32_t *hits);
+
+inline bool overlaps(const AABB &one, const AABB &two)
+{
+	return one.maxX >= two.minX && two.maxX >= one.minX && one.maxY >= two.minY && two.maxY >= one.minY;
+}
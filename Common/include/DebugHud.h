@@ -0,0 +1,46 @@
+// Texto de depuração na tela com uma fonte bitmap 5x7 embutida
+// A fonte cobre ASCII de ' ' a 'Z' (minúsculas viram maiúsculas; o resto vira '?') e vai para
+// uma textura GL_R8 de uma linha só. print acumula quads numa lista na CPU; draw desenha um
+// painel escuro atrás do texto e todos os caracteres num único glDrawArrays, com shader e VAO
+// próprios. Depois do draw, programa, VAO, buffer e textura ligados voltam ao que estavam.
+// Só a thread com o contexto de OpenGL usa o HUD.
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+class DebugHud
+{
+public:
+	static const uint32_t MAX_CHARS = 2048; // por draw; o excedente é ignorado
+
+	DebugHud();
+
+	// Compila o shader e cria a textura da fonte; precisa do contexto atual. scale: pixels da tela por pixel da fonte
+	bool init(float scale = 2.0f);
+	void shutdown();
+
+	// Texto com '\n' a partir de (x, y) em pixels, origem no canto superior esquerdo. color em RGBA8 (R no byte baixo)
+	void print(float x, float y, const char *text, uint32_t color = 0xFFFFFFFF);
+	// Desenha o que foi acumulado desde o último draw e esvazia a lista
+	void draw(int viewportWidth, int viewportHeight);
+
+private:
+	struct Vertex
+	{
+		float x, y;
+		float u, v;
+		uint32_t color;
+	};
+
+	static void setQuad(Vertex *quad, float x0, float y0, float x1, float y1, float u0, float u1, uint32_t color);
+
+	GLuint program, vao, vbo, fontTexture;
+	GLint viewportLocation;
+	float scale;
+	bool ready;
+	std::vector<Vertex> vertices;
+	float minX, minY, maxX, maxY; // retângulo do texto acumulado, para o painel
+};
@@ -0,0 +1,132 @@
+// Pool de entidades de capacidade fixa
+// Os slots são reaproveitados por uma free list e identificados por handles com
+// geração, então um handle antigo nunca aponta para uma entidade que reusou o slot.
+// As entidades vivas ficam compactadas em [0, size()), para que os dados do jogo
+// possam ser guardados em arrays densos e percorridos sem buracos.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct EntityHandle
+{
+	uint32_t index;		 // slot no pool
+	uint32_t generation; // muda a cada despawn do slot
+};
+
+const EntityHandle INVALID_ENTITY = { 0xFFFFFFFFu, 0 };
+
+inline bool operator==(EntityHandle a, EntityHandle b) { return a.index == b.index && a.generation == b.generation; }
+inline bool operator!=(EntityHandle a, EntityHandle b) { return !(a == b); }
+
+// Movimentação que o chamador deve replicar nos seus arrays densos após um despawn:
+// o elemento em "from" (o último) passa para "to" (o buraco). Se from == to, nada a fazer.
+struct DenseMove
+{
+	uint32_t from, to;
+};
+
+class EntityPool
+{
+public:
+	// Toda a memória é reservada aqui; spawn/despawn nunca alocam
+	EntityPool(uint32_t capacity)
+		: generations(capacity, 0), slotToDense(capacity), denseToSlot(capacity), nextFree(capacity), count(0)
+	{
+		for (uint32_t i = 0; i < capacity; i++)
+		{
+			nextFree[i] = i + 1;
+		}
+		freeHead = capacity > 0 ? 0 : END;
+		if (capacity > 0)
+		{
+			nextFree[capacity - 1] = END;
+		}
+	}
+
+	// Retorna INVALID_ENTITY se o pool estiver cheio.
+	// A nova entidade ocupa o índice denso size() - 1.
+	EntityHandle spawn()
+	{
+		if (freeHead == END)
+		{
+			return INVALID_ENTITY;
+		}
+		uint32_t slot = freeHead;
+		freeHead = nextFree[slot];
+
+		slotToDense[slot] = count;
+		denseToSlot[count] = slot;
+		count++;
+
+		EntityHandle handle = { slot, generations[slot] };
+		return handle;
+	}
+
+	// Retorna false (e move vira um no-op) se o handle já estiver morto
+	bool despawn(EntityHandle handle, DenseMove &move)
+	{
+		move.from = move.to = 0;
+		if (!isAlive(handle))
+		{
+			return false;
+		}
+		uint32_t slot = handle.index;
+		uint32_t hole = slotToDense[slot];
+		uint32_t last = count - 1;
+
+		// O último elemento denso tapa o buraco
+		uint32_t lastSlot = denseToSlot[last];
+		denseToSlot[hole] = lastSlot;
+		slotToDense[lastSlot] = hole;
+		count--;
+
+		generations[slot]++;
+		nextFree[slot] = freeHead;
+		freeHead = slot;
+
+		move.from = last;
+		move.to = hole;
+		return true;
+	}
+
+	bool isAlive(EntityHandle handle) const
+	{
+		return handle.index < generations.size() && generations[handle.index] == handle.generation &&
+			   slotToDense[handle.index] < count && denseToSlot[slotToDense[handle.index]] == handle.index;
+	}
+
+	uint32_t denseIndex(EntityHandle handle) const { return slotToDense[handle.index]; }
+
+	EntityHandle handleAt(uint32_t dense) const
+	{
+		uint32_t slot = denseToSlot[dense];
+		EntityHandle handle = { slot, generations[slot] };
+		return handle;
+	}
+
+	uint32_t size() const { return count; }
+	uint32_t capacity() const { return (uint32_t)generations.size(); }
+	bool full() const { return freeHead == END; }
+
+private:
+	static const uint32_t END = 0xFFFFFFFFu;
+
+	std::vector<uint32_t> generations;
+	std::vector<uint32_t> slotToDense;
+	std::vector<uint32_t> denseToSlot;
+	std::vector<uint32_t> nextFree;
+	uint32_t freeHead;
+	uint32_t count;
+};
+
+// Replica um DenseMove num array denso de dados do chamador
+template <class T>
+inline void applyDenseMove(T *data, DenseMove move)
+{
+	if (move.from != move.to)
+	{
+		data[move.to] = data[move.from];
+	}
+}
@@ -0,0 +1,67 @@
+// Aproximações rápidas de seno/cosseno, atan2 e raiz quadrada inversa em float
+// Quem usa escolhe por chamada: as funções não substituem std::sin/std::atan2 em lugar nenhum.
+// Não há desvios dependentes dos dados, então os laços sobre arrays (as versões em lote, em
+// FastMath.cpp) são vetorizados pelo compilador. Erros máximos medidos pelo FastMathBench contra
+// a libm em double:
+//   fastSinCos - 1.5e-7 absoluto para |x| <= 1e4 (a redução perde precisão acima disso)
+//   fastAtan2  - 2.5e-6 rad; fastAtan2(0, 0) = 0
+//   fastRsqrt  - 6.6e-4 relativo para x normal > 0; fastRsqrt(0) é finito e grande (não inf)
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+const float FAST_PI = 3.14159265f;
+
+// Reduz x para r em [-pi/4, pi/4] com x = q * pi/2 + r e avalia os polinômios de seno e cosseno
+// de r (coeficientes minimax da Cephes); q escolhe qual polinômio e qual sinal vão em cada saída
+inline void fastSinCos(float x, float &sine, float &cosine)
+{
+	float q = x * 0.636619772f; // 2 / pi
+	q = (float)(int32_t)(q + (q >= 0.0f ? 0.5f : -0.5f));
+	// pi/2 em três partes, para a redução não perder os bits baixos
+	float r = ((x - q * 1.5703125f) - q * 4.837512969970703125e-4f) - q * 7.54978995489188216e-8f;
+	float r2 = r * r;
+	float s = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+	float c = 1.0f - 0.5f * r2 + r2 * r2 * (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+	int32_t quadrant = (int32_t)q;
+	bool swap = (quadrant & 1) != 0;
+	float sinValue = swap ? c : s;
+	float cosValue = swap ? s : c;
+	sine = (quadrant & 2) ? -sinValue : sinValue;
+	cosine = ((quadrant + 1) & 2) ? -cosValue : cosValue;
+}
+
+// atan de a = menor / maior em [0, 1] por um polinômio ímpar de grau 11 e depois a correção de octante
+inline float fastAtan2(float y, float x)
+{
+	float ax = std::fabs(x), ay = std::fabs(y);
+	bool steep = ay > ax;
+	float big = steep ? ay : ax, small = steep ? ax : ay;
+	float a = small / (big > 1e-30f ? big : 1e-30f);
+	float s = a * a;
+	float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+	// Só constantes dentro dos ?:, para o compilador trocar por máscaras e vetorizar o laço
+	r = (steep ? 1.57079637f : 0.0f) + (steep ? -r : r);
+	r = (x < 0.0f ? FAST_PI : 0.0f) + (x < 0.0f ? -r : r);
+	return std::copysign(r, y);
+}
+
+// Estimativa inicial por bits e um passo de Newton com constantes ajustadas (Moroz et al.)
+inline float fastRsqrt(float x)
+{
+	uint32_t bits;
+	std::memcpy(&bits, &x, sizeof(bits));
+	bits = 0x5F1FFFF9u - (bits >> 1);
+	float y;
+	std::memcpy(&y, &bits, sizeof(y));
+	return y * 0.703952253f * (2.38924456f - x * y * y);
+}
+
+// Versões em lote: out[i] = f(in[i]) para count elementos, vetorizadas pelo compilador
+void fastSinCos(const float *x, float *sines, float *cosines, uint32_t count);
+void fastAtan2(const float *y, const float *x, float *angles, uint32_t count);
+void fastRsqrt(const float *x, float *out, uint32_t count);
@@ -0,0 +1,82 @@
+// Controle do ritmo dos frames (frame pacing)
+// Modos:
+//   PACING_VSYNC       - swap interval 1; o swap espera o vblank.
+//   PACING_UNCAPPED    - swap interval 0 e nenhuma espera: o máximo de frames, com CPU a 100%.
+//   PACING_CAPPED      - swap interval 0; depois do swap dorme até o próximo prazo do frame alvo.
+//   PACING_LOW_LATENCY - swap interval 1, mas o frame só começa (e lê a entrada) o mais tarde
+//                        possível: no vblank esperado menos a estimativa do trabalho do frame.
+// As esperas são híbridas: dormem enquanto sobra mais que o atraso típico do sleep do SO
+// (medido em tempo de execução) e fazem spin no resto, para acertar o prazo sem gastar um
+// núcleo inteiro. Nada aqui chama OpenGL: quem usa aplica swapInterval() com glfwSwapInterval.
+//
+// Uso por frame: beginFrame(), entrada e desenho, beforeSwap(), swap, endFrame().
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+enum PacingMode
+{
+	PACING_VSYNC,
+	PACING_UNCAPPED,
+	PACING_CAPPED,
+	PACING_LOW_LATENCY,
+	NUM_PACING_MODES
+};
+
+// Estatísticas da janela dos últimos frames, em ms
+struct FrameStats
+{
+	uint32_t frames;
+	double p50, p99;		// tempo entre swaps
+	double mean, stddev;	// idem
+	double minimum, maximum;
+	double workMean;		// beginFrame -> beforeSwap
+	double sleepMean;		// tempo dormindo por frame
+	double spinMean;		// tempo em spin por frame
+};
+
+class FramePacer
+{
+public:
+	static const uint32_t HISTORY = 240;
+
+	explicit FramePacer(PacingMode mode = PACING_VSYNC, double targetFps = 60.0);
+
+	void setMode(PacingMode mode, double targetFps);
+	PacingMode mode() const { return current; }
+	double targetFps() const { return 1000.0 / periodMs; }
+	int swapInterval() const { return current == PACING_VSYNC || current == PACING_LOW_LATENCY ? 1 : 0; }
+	static const char *modeName(PacingMode mode);
+
+	void beginFrame();
+	void beforeSwap();
+	void endFrame();
+
+	FrameStats stats() const;
+	uint64_t frameCount() const { return frames; }
+
+	// Espera até deadline dormindo e terminando em spin; soma os tempos gastos em cada parte
+	void sleepUntil(std::chrono::steady_clock::time_point deadline);
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	static double toMs(Clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); }
+	Clock::duration fromMs(double ms) const;
+
+	PacingMode current;
+	double periodMs;
+
+	Clock::time_point workStart, lastSwap, nextDeadline;
+	double workEstimate;	 // ms; sobe na hora e desce devagar, para cobrir os frames mais lentos
+	double frameSleep, frameSpin;
+
+	// Atraso observado de um sleep de 1 ms (média e variância de Welford)
+	double sleepMean, sleepM2;
+	uint64_t sleepSamples;
+
+	uint64_t frames;
+	double frameTimes[HISTORY], workTimes[HISTORY], sleepTimes[HISTORY], spinTimes[HISTORY];
+};
@@ -0,0 +1,47 @@
+// Geração procedural de geometria (círculo, estrela, espiral) em malhas indexadas
+// Nenhum sin/cos por vértice: os ângulos i * slice saem de uma tabela em dois níveis, com o
+// seno/cosseno exato no início de cada pedaço de 64 ângulos e as 64 rotações do pedaço
+// pré-calculadas; cada vértice custa uma rotação (4 multiplicações), sem dependência entre
+// vértices, e o erro não acumula ao longo da volta. Os tamanhos são exatos (sem push_back) e,
+// com um JobSystem, contagens grandes são divididas entre as threads.
+//
+// Layout comum: vértice 0 é o centro, a borda (ou a curva) ocupa [1, n].
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "JobSystem.h"
+
+struct Mesh
+{
+	std::vector<float> vertices;   // x, y, z por vértice
+	std::vector<uint32_t> indices; // triângulos (círculo, estrela) ou pares de segmentos (espiral)
+
+	uint32_t vertexCount() const { return (uint32_t)(vertices.size() / 3); }
+};
+
+// Cosseno e seno de n ângulos igualmente espaçados numa volta, reaproveitáveis entre malhas
+class SinCosTable
+{
+public:
+	explicit SinCosTable(uint32_t slices, JobSystem *jobs = nullptr);
+
+	uint32_t size() const { return (uint32_t)cosTable.size(); }
+	const float *cosines() const { return cosTable.data(); }
+	const float *sines() const { return sinTable.data(); }
+
+private:
+	std::vector<float> cosTable;
+	std::vector<float> sinTable;
+};
+
+// Leque indexado: table.size() vértices na borda e o mesmo número de triângulos
+void generateCircle(Mesh &mesh, const SinCosTable &table, float radius, JobSystem *jobs = nullptr);
+// Como o círculo, com o raio alternando entre maxRadius (pontas, índices pares) e minRadius
+void generateStar(Mesh &mesh, const SinCosTable &table, float minRadius, float maxRadius, JobSystem *jobs = nullptr);
+
+// Espiral de Arquimedes: ponto i no ângulo i * slice (i * slice < maxAngle) com raio
+// startRadius + i * growth, ligado ao seguinte por um segmento (GL_LINES)
+uint32_t spiralPointCount(float maxAngle, float slice);
+void generateSpiral(Mesh &mesh, float maxAngle, float slice, float startRadius, float growth, JobSystem *jobs = nullptr);
@@ -0,0 +1,23 @@
+// Tipos da glm para a matemática das entidades e da renderização
+// A glm 0.9.8 escolhe o conjunto de instruções pelo compilador (SSE2 em qualquer x64), mas só usa os
+// intrínsecos de glm/simd nos tipos alinhados (aligned_highp): vec3, vec4 e mat4 comuns são sempre escalares.
+// Com GLM_SIMD_MATH definido (configuração Release|x64), math_vec4 e math_mat4 são os tipos alinhados
+// em 16 bytes, e as operações de vec4 e os produtos de mat4 viram SSE; sem ele, são os tipos comuns.
+// GlmSimdBench mede as duas versões e confere que dão o mesmo resultado.
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_aligned.hpp>
+
+#ifdef GLM_SIMD_MATH
+#if !GLM_HAS_ALIGNED_TYPE || GLM_ARCH == GLM_ARCH_PURE
+#error "GLM_SIMD_MATH precisa de tipos alinhados e de SSE2 ou superior na glm"
+#endif
+const glm::precision mathPrecision = glm::aligned_highp;
+#else
+const glm::precision mathPrecision = glm::highp;
+#endif
+
+typedef glm::tvec4<float, mathPrecision> math_vec4;
+typedef glm::tmat4x4<float, mathPrecision> math_mat4;
@@ -0,0 +1,88 @@
+// Zonas de GPU com queries de timestamp, lidas com alguns frames de atraso
+// Cada zona grava dois glQueryCounter(GL_TIMESTAMP) (aninháveis, ao contrário de
+// GL_TIME_ELAPSED), e o frame inteiro fica entre um glBeginQuery/glEndQuery(GL_TIME_ELAPSED).
+// Há FRAMES conjuntos de queries em rodízio: o resultado de um frame só é lido quando o
+// conjunto dele volta a ser usado, FRAMES - 1 frames depois, e só se já estiver disponível;
+// senão é descartado. Assim a CPU nunca espera a GPU.
+// Os timestamps da GPU são convertidos para o relógio do Profiler e vão para o anel "GPU".
+// Só a thread com o contexto de OpenGL usa este profiler.
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include "Profiler.h"
+
+class GpuProfiler
+{
+public:
+	static const uint32_t FRAMES = 4;     // conjuntos de queries em voo
+	static const uint32_t MAX_ZONES = 32; // zonas por frame; as excedentes são ignoradas
+
+	GpuProfiler();
+
+	// Cria as queries; precisa do contexto atual
+	void init();
+	void shutdown();
+
+	// Lê o frame que ocupava este conjunto (se pronto) e começa a medir o frame atual
+	void beginFrame();
+	void endFrame();
+
+	// Retorna o índice da zona ou MAX_ZONES se não houver espaço
+	uint32_t beginZone(const char *name);
+	void endZone(uint32_t zone);
+
+	// Tempo de GPU do último frame lido (GL_TIME_ELAPSED), em ms
+	double lastFrameMs() const { return frameMs; }
+	uint64_t droppedFrames() const { return dropped; }
+
+private:
+	struct FrameQueries
+	{
+		GLuint elapsed;
+		GLuint timestamps[2 * MAX_ZONES];
+		const char *names[MAX_ZONES];
+		uint32_t zones;
+		bool pending;
+	};
+
+	void collect(FrameQueries &frame);
+	void calibrate();
+
+	FrameQueries frames[FRAMES];
+	uint32_t current;
+	bool ready;
+	int64_t gpuToCpu; // soma ao timestamp da GPU para chegar ao relógio do Profiler
+	uint64_t frameCount;
+	uint64_t dropped;
+	double frameMs;
+};
+
+extern GpuProfiler gpuProfiler;
+
+class GpuZone
+{
+public:
+	explicit GpuZone(const char *name) : zone(gpuProfiler.beginZone(name)) {}
+	~GpuZone() { gpuProfiler.endZone(zone); }
+	GpuZone(const GpuZone &) = delete;
+	GpuZone &operator=(const GpuZone &) = delete;
+
+private:
+	uint32_t zone;
+};
+
+#ifdef PROFILER_ENABLED
+#define PROFILE_GPU_ZONE(name) GpuZone PROFILE_CONCAT(gpuZone, __LINE__)(name)
+#define PROFILE_GPU_INIT() gpuProfiler.init()
+#define PROFILE_GPU_SHUTDOWN() gpuProfiler.shutdown()
+#define PROFILE_GPU_BEGIN_FRAME() gpuProfiler.beginFrame()
+#define PROFILE_GPU_END_FRAME() gpuProfiler.endFrame()
+#else
+#define PROFILE_GPU_ZONE(name)
+#define PROFILE_GPU_INIT()
+#define PROFILE_GPU_SHUTDOWN()
+#define PROFILE_GPU_BEGIN_FRAME()
+#define PROFILE_GPU_END_FRAME()
+#endif
@@ -0,0 +1,48 @@
+// Contexto de OpenGL sem janela visível, desenhando num FBO (cor RGBA8 + profundidade)
+// O backend é escolhido na compilação:
+//   HEADLESS_EGL    - EGL surfaceless (Mesa: llvmpipe sem display); linkar com -lEGL
+//   HEADLESS_OSMESA - OSMesa, renderização em software da Mesa; linkar com -lOSMesa
+//   (nenhum)        - janela oculta da GLFW, para rodar o mesmo código no Windows
+// Nos três casos a GLAD é carregada e o FBO fica ligado como destino do desenho, então o código
+// de renderização do jogo roda sem mudanças. Sem swap, finish() é o que fecha o frame.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class HeadlessContext
+{
+public:
+	HeadlessContext();
+	~HeadlessContext();
+	HeadlessContext(const HeadlessContext &) = delete;
+	HeadlessContext &operator=(const HeadlessContext &) = delete;
+
+	// Cria o contexto (GL 4.0 core), torna-o atual nesta thread e liga um FBO width x height
+	bool create(int width, int height);
+	void destroy();
+
+	// Liga de novo o FBO e a viewport (depois de quem desenhou em outro framebuffer)
+	void bindFramebuffer();
+	// Espera a GPU terminar o que foi enviado
+	void finish();
+	// Cor do FBO em RGBA8, da linha de baixo para a de cima (como o glReadPixels)
+	void readPixels(std::vector<uint8_t> &rgba);
+
+	int width() const { return fboWidth; }
+	int height() const { return fboHeight; }
+	const std::string &error() const { return lastError; }
+	static const char *backendName();
+
+private:
+	bool createContext();
+	void destroyContext();
+
+	int fboWidth, fboHeight;
+	unsigned int framebuffer, colorBuffer, depthBuffer;
+	void *display, *context, *window; // do backend; window só na GLFW
+	std::vector<uint8_t> osmesaBuffer; // destino obrigatório do OSMesa (não é lido: o desenho vai para o FBO)
+	std::string lastError;
+};
@@ -0,0 +1,20 @@
+// Comparação perceptual de imagens RGBA8 (para as imagens de referência dos testes de renderização)
+// A diferença de cada pixel é medida em YIQ, com os pesos do pixelmatch: o olho é mais sensível
+// à luminância (Y) que às componentes de cor (I e Q). Pixels com alpha são compostos sobre branco
+// antes da conversão. threshold vai de 0 (qualquer diferença conta) a 1 (nada conta); 0.1 ignora
+// variações de arredondamento e de rasterização entre drivers que não se veem na tela.
+
+#pragma once
+
+#include <cstdint>
+
+struct ImageDiff
+{
+	uint32_t differentPixels; // pixels acima do limiar
+	double fraction;		  // differentPixels / total
+	double maxDelta;		  // maior diferença, na mesma escala do threshold
+};
+
+// diff (opcional, width * height * 4): imagem esmaecida com os pixels diferentes em vermelho
+ImageDiff compareImages(const uint8_t *expected, const uint8_t *actual, int width, int height, float threshold = 0.1f,
+						uint8_t *diff = nullptr);
@@ -0,0 +1,82 @@
+// Entrada com instante: eventos de teclado carimbados na chegada e aplicados no tick em que aconteceram
+// A thread da janela (callbacks da GLFW) empilha os eventos numa fila SPSC sem lock; a simulação,
+// em passo fixo, consome só os eventos anteriores ao fim do tick e integra quanto tempo do tick
+// cada tecla ficou pressionada. Um toque mais curto que um tick ainda conta, proporcionalmente.
+// LatencySampler guarda as últimas amostras de latência entrada -> present.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include "SpscQueue.h"
+
+const int MAX_KEYS = 1024;
+
+// Relógio comum da entrada e das medições de latência, em ns
+inline int64_t inputClockNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct InputEvent
+{
+	int64_t timestamp; // inputClockNs() na chegada
+	int32_t key;
+	int32_t action; // GLFW_PRESS = 1, GLFW_RELEASE = 0; repetições são ignoradas
+};
+
+class InputQueue
+{
+public:
+	// Lado da janela: carimba e empilha; false se a fila estiver cheia
+	bool push(int key, int action);
+	// Evento já carimbado (replay, testes)
+	bool push(const InputEvent &event) { return events.push(event); }
+	// Lado da simulação: retira o próximo evento só se ele aconteceu antes de until
+	bool popBefore(int64_t until, InputEvent &event);
+
+private:
+	SpscQueue<InputEvent, 1024> events;
+};
+
+class KeyboardState
+{
+public:
+	KeyboardState();
+
+	// Aplica os eventos do tick [tickStart, tickEnd); eventos posteriores ficam para o próximo.
+	// Retorna quantos eventos foram aplicados.
+	uint32_t advance(InputQueue &queue, int64_t tickStart, int64_t tickEnd);
+
+	bool down(int key) const { return isDown[key]; }
+	// Fração do último tick em que a tecla ficou pressionada, de 0 a 1
+	float heldFraction(int key) const { return held[key]; }
+	// Instante do evento mais antigo aplicado no último tick, ou 0 se não houve eventos
+	int64_t oldestEvent() const { return oldest; }
+
+private:
+	bool isDown[MAX_KEYS];
+	int64_t downSince[MAX_KEYS];
+	float held[MAX_KEYS];
+	int active[MAX_KEYS]; // teclas pressionadas ou com held do último tick; só elas são visitadas
+	int activeCount;
+	bool listed[MAX_KEYS];
+	int64_t oldest;
+};
+
+class LatencySampler
+{
+public:
+	static const uint32_t HISTORY = 256;
+
+	LatencySampler() : count(0) {}
+	void add(double ms) { samples[count++ % HISTORY] = ms; }
+	uint64_t sampleCount() const { return count; }
+
+	// Percentil p (0 a 1) das últimas amostras, em ms
+	double percentile(double p) const;
+
+private:
+	double samples[HISTORY];
+	uint64_t count;
+};
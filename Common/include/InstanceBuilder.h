@@ -0,0 +1,86 @@
+// Geração paralela dos dados por instância dos sprites (transformação, retângulo de UV, cor)
+// As instâncias saem agrupadas por camada, cada camada contígua e na ordem original, para que
+// cada camada vire um único draw instanciado. O agrupamento é um counting sort em blocos:
+//   1. cada bloco de sprites conta quantas instâncias tem em cada camada (em paralelo);
+//   2. a soma de prefixos (bloco x camada) reserva para cada bloco uma fatia disjunta de cada camada;
+//   3. cada bloco escreve as suas instâncias nas suas fatias (em paralelo, sem sincronização).
+// O destino pode ser um buffer mapeado da OpenGL: cada worker escreve em sequência nas suas fatias.
+// O formato da instância é escolhido em tempo de compilação (SpriteInstance<Rotates>): sem rotação,
+// cada instância é uma cópia de campos, sem seno nem cosseno.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "JobSystem.h"
+#include "Transform2D.h"
+
+// Entrada: um sprite como a simulação o descreve
+struct InstanceSprite
+{
+	float x, y;			 // centro
+	float width, height; // dimensões
+	float angle;		 // rotação em radianos (ignorada por SpriteInstance<false>)
+	float u0, v0;		 // canto do quadro na textura
+	float du, dv;		 // tamanho do quadro na textura
+	uint32_t tint;		 // RGBA8, 0xFFFFFFFF = sem tint
+	uint32_t layer;		 // camada de desenho (uma textura por camada)
+};
+
+// Saída: o que o vertex shader lê por instância. 36 bytes sem rotação, 44 com
+template <bool Rotates>
+struct SpriteInstance
+{
+	Transform2D<Rotates> transform;
+	float uv[4];   // u0, v0, du, dv
+	uint32_t tint; // RGBA8
+};
+
+// Uma instância, sem paralelismo
+template <bool Rotates>
+inline void writeInstance(const InstanceSprite &sprite, SpriteInstance<Rotates> &out)
+{
+	out.transform = Transform2D<Rotates>::make(sprite.x, sprite.y, sprite.width, sprite.height, sprite.angle);
+	out.uv[0] = sprite.u0;
+	out.uv[1] = sprite.v0;
+	out.uv[2] = sprite.du;
+	out.uv[3] = sprite.dv;
+	out.tint = sprite.tint;
+}
+
+class InstanceBuilder
+{
+public:
+	InstanceBuilder(uint32_t layerCount, uint32_t blockSize = 4096);
+
+	// Escreve as n instâncias em out (espaço para n), agrupadas por camada. Bloqueia até terminar;
+	// a thread que chama ajuda os workers.
+	template <bool Rotates>
+	void build(JobSystem &jobs, const InstanceSprite *sprites, uint32_t n, SpriteInstance<Rotates> *out)
+	{
+		target = out;
+		writer = writeBlocks<Rotates>;
+		buildLayers(jobs, sprites, n);
+	}
+
+	// Posição e tamanho de cada camada em out, válidos depois de build
+	uint32_t layerStart(uint32_t layer) const { return starts[layer]; }
+	uint32_t layerSize(uint32_t layer) const { return starts[layer + 1] - starts[layer]; }
+	uint32_t layerCount() const { return layers; }
+
+private:
+	void buildLayers(JobSystem &jobs, const InstanceSprite *sprites, uint32_t n);
+	static void countBlocks(void *data, uint32_t firstBlock, uint32_t lastBlock);
+	template <bool Rotates>
+	static void writeBlocks(void *data, uint32_t firstBlock, uint32_t lastBlock);
+
+	uint32_t layers, blockSize;
+
+	const InstanceSprite *source;
+	void *target;		// SpriteInstance<Rotates>, conforme o writer
+	JobFunction writer; // writeBlocks<Rotates>
+	uint32_t count;
+
+	std::vector<uint32_t> blockOffsets; // [bloco * layers + camada]: contagem, depois cursor de escrita
+	std::vector<uint32_t> starts;		// layers + 1 entradas
+};
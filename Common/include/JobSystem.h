@@ -0,0 +1,131 @@
+// Sistema de jobs com roubo de trabalho (work stealing)
+// Cada thread tem um deque próprio: empilha e desempilha jobs no fundo (LIFO, cache quente) e,
+// quando fica sem trabalho, rouba do topo do deque de outra thread (FIFO, pedaços maiores).
+// Um parallelFor divide o intervalo ao meio sob demanda, até o tamanho mínimo (grain), então
+// threads ociosas sempre acham metades grandes para roubar.
+// Dependências usam contadores: todo job decrementa o seu JobCounter ao terminar, e os jobs
+// registrados com runAfter/parallelForAfter só entram nos deques quando o contador deles zera.
+//
+// A thread que cria o sistema é a thread 0 e participa do trabalho dentro de wait. run, wait
+// e os parallelFor só podem ser chamados por ela ou de dentro de um job.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+typedef void (*JobFunction)(void *data, uint32_t first, uint32_t last);
+
+struct Job
+{
+	JobFunction function;
+	void *data;
+	uint32_t first, last;
+	uint32_t grain; // intervalos maiores que isso são divididos antes de executar
+	JobCounter *counter;
+};
+
+// Jobs só podem ser acrescentados a um contador ocioso (antes de qualquer wait) ou de dentro
+// de um job que ele mesmo conta; assim o último job a terminar é de fato o último.
+class JobCounter
+{
+public:
+	JobCounter() : pending(0) {}
+	JobCounter(const JobCounter &) = delete;
+	JobCounter &operator=(const JobCounter &) = delete;
+
+	bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> pending;
+	std::mutex lock;				  // protege as continuações
+	std::vector<Job *> continuations; // jobs liberados quando pending chega a zero
+};
+
+class JobSystem
+{
+public:
+	// threadCount inclui a thread que cria o sistema; com 1, tudo roda dentro de wait
+	explicit JobSystem(uint32_t threadCount);
+	~JobSystem();
+	JobSystem(const JobSystem &) = delete;
+	JobSystem &operator=(const JobSystem &) = delete;
+
+	uint32_t threadCount() const { return (uint32_t)queues.size(); }
+
+	void run(JobFunction function, void *data, uint32_t first, uint32_t last, uint32_t grain, JobCounter &counter);
+	// Só executa depois que dependency zerar; counter já conta o job a partir desta chamada
+	void runAfter(JobCounter &dependency, JobFunction function, void *data, uint32_t first, uint32_t last, uint32_t grain, JobCounter &counter);
+
+	// body(first, last) sobre [0, count); body precisa continuar vivo até o wait de counter
+	template <class F>
+	void parallelFor(uint32_t count, uint32_t grain, F &body, JobCounter &counter)
+	{
+		run(&invokeRange<F>, &body, 0, count, grain, counter);
+	}
+
+	template <class F>
+	void parallelForAfter(JobCounter &dependency, uint32_t count, uint32_t grain, F &body, JobCounter &counter)
+	{
+		runAfter(dependency, &invokeRange<F>, &body, 0, count, grain, counter);
+	}
+
+	// Executa jobs (os próprios ou roubados) até counter zerar
+	void wait(JobCounter &counter);
+
+private:
+	// Deque de Chase-Lev com capacidade fixa (versão C11 de Lê et al., 2013).
+	// Só a dona chama push/pop; qualquer thread chama steal.
+	struct WorkQueue
+	{
+		static const uint32_t CAPACITY = 4096;
+
+		alignas(64) std::atomic<int64_t> top;
+		alignas(64) std::atomic<int64_t> bottom;
+		std::atomic<Job *> slots[CAPACITY];
+
+		WorkQueue() : top(0), bottom(0) {}
+		bool push(Job *job);
+		Job *pop();
+		Job *steal();
+	};
+
+	// Jobs de cada thread saem de um anel; um job só é sobrescrito depois de CAPACITY alocações
+	struct JobRing
+	{
+		Job jobs[WorkQueue::CAPACITY];
+		uint32_t next = 0;
+	};
+
+	template <class F>
+	static void invokeRange(void *data, uint32_t first, uint32_t last)
+	{
+		(*(F *)data)(first, last);
+	}
+
+	uint32_t currentThread() const;
+	Job *allocate(JobFunction function, void *data, uint32_t first, uint32_t last, uint32_t grain, JobCounter &counter);
+	void submit(Job *job);
+	Job *findJob(uint32_t self);
+	void execute(Job *job);
+	void finish(JobCounter &counter);
+	void workerLoop(uint32_t self);
+
+	std::vector<WorkQueue *> queues;
+	std::vector<JobRing *> rings;
+	std::vector<std::thread> workers;
+
+	std::atomic<uint32_t> queued; // jobs nos deques, para os workers saberem quando dormir
+	std::atomic<uint32_t> sleeping;
+	std::atomic<bool> quit;
+	std::mutex sleepLock;
+	std::condition_variable wake;
+};
@@ -0,0 +1,165 @@
+// Logger assíncrono para eventos do jogo
+// Quem loga só copia um registro binário (formato, argumentos, nível, categoria, instante) para
+// um anel sem lock de vários produtores e um consumidor (MPSC, fila de Vyukov). Uma thread de
+// fundo formata e escreve os registros, então o caminho quente nunca formata texto nem espera o
+// terminal. Com o anel cheio o registro é descartado e contado, nunca bloqueia.
+//
+// O formato usa {} para cada argumento: log(LOG_INFO, cat, "Score: {}", score).
+// Strings (o formato e argumentos const char*) são guardadas como ponteiro e formatadas depois:
+// precisam continuar vivas até a escrita, então use só literais.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+enum LogLevel : uint8_t
+{
+	LOG_DEBUG,
+	LOG_INFO,
+	LOG_WARNING,
+	LOG_ERROR
+};
+
+class Logger
+{
+public:
+	static const uint32_t MAX_ARGS = 4;
+	static const uint32_t MAX_CATEGORIES = 32;
+
+	// capacity: registros no anel (potência de 2)
+	explicit Logger(FILE *out = stdout, uint32_t capacity = 4096);
+	~Logger();
+	Logger(const Logger &) = delete;
+	Logger &operator=(const Logger &) = delete;
+
+	// Registra uma categoria; maxPerSecond = 0 desliga o limite. Registre sempre da mesma thread.
+	uint16_t addCategory(const char *name, uint32_t maxPerSecond = 0);
+	void setLevel(LogLevel level) { minLevel.store(level, std::memory_order_relaxed); }
+
+	template <class... Args>
+	void log(LogLevel level, uint16_t category, const char *format, Args... args)
+	{
+		static_assert(sizeof...(Args) <= MAX_ARGS, "argumentos demais para um registro de log");
+		if (level < minLevel.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+		Record record;
+		record.format = format;
+		record.category = category;
+		record.level = level;
+		record.argCount = 0;
+		int unpack[] = { 0, (pack(record, args), 0)... };
+		(void)unpack;
+		submit(record);
+	}
+
+	// Espera a thread de fundo escrever tudo que já foi enfileirado
+	void flush();
+
+	// Registros descartados por anel cheio ou por limite de categoria
+	uint64_t droppedCount() const;
+
+private:
+	enum ArgType : uint8_t
+	{
+		ARG_INT,
+		ARG_UINT,
+		ARG_DOUBLE,
+		ARG_BOOL,
+		ARG_STRING
+	};
+
+	union Arg
+	{
+		int64_t i;
+		uint64_t u;
+		double d;
+		const char *s;
+	};
+
+	struct Record
+	{
+		int64_t timestamp; // ns desde a criação do logger
+		const char *format;
+		uint16_t category;
+		uint8_t level;
+		uint8_t argCount;
+		ArgType types[MAX_ARGS];
+		Arg args[MAX_ARGS];
+	};
+
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence;
+		Record record;
+	};
+
+	struct Category
+	{
+		const char *name;
+		uint32_t maxPerSecond;
+		std::atomic<int64_t> windowStart; // ns
+		std::atomic<uint32_t> used;		  // registros aceitos na janela atual
+		std::atomic<uint32_t> suppressed; // descartados desde o último aviso
+	};
+
+	template <class T>
+	static void pack(Record &record, T value)
+	{
+		Arg &arg = record.args[record.argCount];
+		ArgType &type = record.types[record.argCount++];
+		if (std::is_same<T, bool>::value)
+		{
+			type = ARG_BOOL;
+			arg.u = value ? 1 : 0;
+		}
+		else if (std::is_floating_point<T>::value)
+		{
+			type = ARG_DOUBLE;
+			arg.d = (double)value;
+		}
+		else if (std::is_signed<T>::value)
+		{
+			type = ARG_INT;
+			arg.i = (int64_t)value;
+		}
+		else
+		{
+			type = ARG_UINT;
+			arg.u = (uint64_t)value;
+		}
+	}
+	static void pack(Record &record, const char *value)
+	{
+		record.types[record.argCount] = ARG_STRING;
+		record.args[record.argCount++].s = value;
+	}
+
+	int64_t now() const;
+	void submit(Record &record);
+	bool pop(Record &record);
+	void write(const Record &record);
+	void writerLoop();
+
+	FILE *out;
+	int64_t epoch;
+	std::vector<Slot> slots;
+	uint64_t mask;
+	alignas(64) std::atomic<uint64_t> tail; // produtores
+	alignas(64) std::atomic<uint64_t> head;	// só a thread de fundo escreve
+	std::atomic<uint64_t> written;				// registros já escritos e com flush
+	alignas(64) std::atomic<uint64_t> dropped;
+	std::atomic<uint8_t> minLevel;
+
+	Category categories[MAX_CATEGORIES];
+	std::atomic<uint16_t> categoryCount;
+
+	std::atomic<bool> quit;
+	std::thread writer;
+};
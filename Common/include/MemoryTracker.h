@@ -0,0 +1,114 @@
+// Contabilidade de memória por subsistema: bytes vivos, pico, alocações vivas e totais por tag
+// Na CPU, só o que passa pelo rastreador é contado: o TaggedAllocator (containers da STL), as
+// funções memoryAlloc/Realloc/Free (a stb_image usa como STBI_MALLOC) e trackAllocation/trackFree
+// para quem já sabe o tamanho. Os contadores são atômicos: os workers do JobSystem e a thread da
+// simulação também alocam.
+// Na GPU o valor é uma estimativa: installGpuMemoryTracking (GpuMemoryTracker.cpp, o único que
+// depende da GLAD) troca os ponteiros que criam e destroem buffers, texturas e renderbuffers (como o
+// installRenderStats) e guarda o tamanho de cada objeto. Formatos sem tamanho explícito contam 4
+// bytes por pixel e glGenerateMipmap soma 1/3 do nível 0; o driver pode alocar mais (alinhamento,
+// cópias de sombra).
+// memoryStats é barato e pode ser lido todo frame; setMemoryBudget marca a tag no relatório quando
+// o uso passa do orçamento.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+enum class MemoryTag : uint8_t
+{
+	General,
+	Sprites, // colunas do SpriteStore
+	Spatial, // grade de colisão
+	Images,	 // decodificação da stb_image
+	Shaders, // código-fonte lido dos arquivos
+	Tiles,	 // camadas e chunks do TileMap
+	Count
+};
+
+enum class GpuMemoryKind : uint8_t
+{
+	Buffers,
+	Textures,
+	Renderbuffers,
+	Count
+};
+
+struct MemoryStats
+{
+	int64_t bytes;
+	int64_t peakBytes;
+	int64_t liveAllocations;
+	uint64_t totalAllocations;
+	int64_t budget; // 0 = sem orçamento
+};
+
+// Alocação com cabeçalho (tamanho e tag): para APIs em C, cujo free não informa o tamanho
+void *memoryAlloc(MemoryTag tag, size_t size);
+void *memoryRealloc(MemoryTag tag, void *pointer, size_t size);
+void memoryFree(void *pointer);
+
+// Só a contagem, para alocações feitas por outro meio
+void trackAllocation(MemoryTag tag, size_t size);
+void trackFree(MemoryTag tag, size_t size);
+
+// Depois do gladLoadGLLoader; chamar de novo não faz nada. Só a thread de OpenGL altera esses valores
+void installGpuMemoryTracking();
+// Um objeto da GPU mudou de oldBytes para newBytes (0 = criado/destruído)
+void trackGpuResize(GpuMemoryKind kind, int64_t oldBytes, int64_t newBytes);
+
+MemoryStats memoryStats(MemoryTag tag);
+MemoryStats gpuMemoryStats(GpuMemoryKind kind);
+void setMemoryBudget(MemoryTag tag, int64_t bytes);
+void setGpuMemoryBudget(GpuMemoryKind kind, int64_t bytes);
+const char *memoryTagName(MemoryTag tag);
+const char *gpuMemoryKindName(GpuMemoryKind kind);
+
+// Uma linha por tag e por tipo de objeto da GPU; devolve o tamanho como snprintf
+int formatMemoryStats(char *text, size_t size);
+void dumpMemoryStats(FILE *file);
+
+template <class T, MemoryTag Tag>
+struct TaggedAllocator
+{
+	using value_type = T;
+	// Necessário: a rebind automática do allocator_traits não cobre o parâmetro Tag
+	template <class U>
+	struct rebind
+	{
+		using other = TaggedAllocator<U, Tag>;
+	};
+
+	TaggedAllocator() = default;
+	template <class U>
+	TaggedAllocator(const TaggedAllocator<U, Tag> &) {}
+
+	T *allocate(size_t n)
+	{
+		T *pointer = std::allocator<T>().allocate(n);
+		trackAllocation(Tag, n * sizeof(T));
+		return pointer;
+	}
+
+	void deallocate(T *pointer, size_t n)
+	{
+		trackFree(Tag, n * sizeof(T));
+		std::allocator<T>().deallocate(pointer, n);
+	}
+
+	template <class U>
+	bool operator==(const TaggedAllocator<U, Tag> &) const { return true; }
+	template <class U>
+	bool operator!=(const TaggedAllocator<U, Tag> &) const { return false; }
+};
+
+template <class T, MemoryTag Tag>
+using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+template <MemoryTag Tag>
+using TaggedString = std::basic_string<char, std::char_traits<char>, TaggedAllocator<char, Tag>>;
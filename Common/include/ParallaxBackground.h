@@ -0,0 +1,58 @@
+// Fundo em parallax: faixas de uma folha pequena que repete em x, desenhadas num draw só
+// A folha é uma textura com as camadas empilhadas, cada uma ocupando a largura inteira e uma faixa de
+// linhas [vTop, vBottom] (v = 0 é a primeira linha da imagem). Como a folha usa GL_REPEAT em s, cada
+// camada repete sozinha em x; ela cobre uma faixa [bottom, top] do mundo em y, e a altura da faixa com
+// a proporção das linhas dá o período da repetição. O deslocamento de cada camada é
+// rate * scroll + drift * segundos, aplicado como offset da coordenada u no vertex shader.
+// Cada camada é um quad da largura visível num VBO estático (refeito só quando as camadas mudam), e o
+// draw desenha todos de trás para frente: um draw, uma textura e uma leitura por pixel, com o
+// fragment shader só amostrando. Onde as faixas se sobrepõem, o blend mistura as camadas pelo alfa.
+// A folha só precisa ter a resolução da tela. Só a thread com o contexto de OpenGL usa o ParallaxBackground.
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+
+const uint32_t MAX_PARALLAX_LAYERS = 4; // um componente de vec4 por camada no shader
+
+class ParallaxBackground
+{
+public:
+	ParallaxBackground();
+
+	// Compila o shader e cria o VBO; precisa do contexto atual
+	bool init();
+	void shutdown();
+
+	// Matriz 4x4 em colunas, como value_ptr da glm
+	void setProjection(const float *matrix);
+
+	// Ajusta o wrap da folha (repete em s, preso à borda em t) e o filtro linear; vem antes das camadas
+	void setSheet(GLuint texture);
+
+	// Camadas na ordem de trás para frente; falha se já houver MAX_PARALLAX_LAYERS. rate é a fração do
+	// scroll que a camada acompanha (0 fica parada, 1 anda junto) e drift um deslizamento próprio em
+	// pixels por segundo
+	bool addLayer(float vTop, float vBottom, float bottom, float top, float rate, float drift);
+	void clearLayers();
+
+	// Faixa visível em x, em coordenadas do mundo; scroll é o deslocamento horizontal da câmera
+	void draw(float minX, float maxX, float scroll, float seconds);
+
+	uint32_t layerCount() const { return layers; }
+	float period(uint32_t layer) const { return periods[layer]; } // em pixels do mundo
+
+private:
+	GLuint sheet;
+	int sheetWidth, sheetHeight;
+	float rows[MAX_PARALLAX_LAYERS][2];	 // vTop, vBottom, já com meio texel de margem
+	float bands[MAX_PARALLAX_LAYERS][2]; // bottom, top
+	float periods[MAX_PARALLAX_LAYERS];
+	float rates[MAX_PARALLAX_LAYERS], drifts[MAX_PARALLAX_LAYERS];
+	uint32_t layers;
+	bool dirty; // o VBO não tem as camadas atuais
+
+	GLuint program, vao, vbo;
+	GLint projectionLocation, areaLocation, periodLocation, offsetLocation;
+};
@@ -0,0 +1,14 @@
+// Gravação de PNG RGBA8 sem dependências
+// Cada linha usa o filtro PNG que dá a menor soma de resíduos; a compressão é deflate com os
+// códigos de Huffman fixos e LZ77 com tabela de hash. Comprime bem menos que um zlib completo, mas
+// fundos lisos e sprites repetidos (o caso das capturas de tela) ficam pequenos.
+// Para ler PNG, use a stb_image.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// rgba: width * height * 4 bytes, linha de cima primeiro
+std::vector<uint8_t> encodePng(const uint8_t *rgba, int width, int height);
+bool writePng(const char *path, const uint8_t *rgba, int width, int height);
@@ -0,0 +1,105 @@
+// Profiler de frame: zonas de CPU com escopo (RAII) gravadas num anel por thread
+// PROFILE_ZONE("nome") mede do ponto da declaração até o fim do escopo. Cada thread grava só no
+// seu anel (sem lock; o registro da thread na primeira zona é a única parte com mutex), e o
+// anel sobrescreve as zonas mais antigas. writeChromeTrace exporta o que estiver nos anéis no
+// formato trace_event do Chrome (abra em chrome://tracing ou ui.perfetto.dev).
+// As zonas de GPU ficam em GpuProfiler.h e vão para um anel próprio, mostrado como a thread "GPU".
+//
+// Sem PROFILER_ENABLED definido, as macros não geram código: custo zero.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Uma zona concluída; campos atômicos para o dump poder ler enquanto a thread grava
+struct ProfileEvent
+{
+	std::atomic<const char *> name; // literal: só o ponteiro é guardado
+	std::atomic<int64_t> start;     // ns desde a criação do profiler
+	std::atomic<int64_t> end;
+};
+
+struct ProfileRing
+{
+	static const uint32_t CAPACITY = 16384;
+
+	uint32_t id;
+	const char *threadName;
+	std::atomic<uint64_t> written; // total de zonas gravadas (a posição é written % CAPACITY)
+	ProfileEvent events[CAPACITY];
+};
+
+class Profiler
+{
+public:
+	Profiler();
+	Profiler(const Profiler &) = delete;
+	Profiler &operator=(const Profiler &) = delete;
+
+	int64_t now() const
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+	}
+
+	// Desligado em tempo de execução, cada zona custa uma leitura atômica e um teste
+	void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+	bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+	// Nome da thread que chama, como aparece no trace (literal)
+	void setThreadName(const char *name);
+	// Grava no anel da thread que chama
+	void record(const char *name, int64_t start, int64_t end);
+	// Grava no anel da GPU; só a thread de OpenGL chama
+	void recordGpu(const char *name, int64_t start, int64_t end);
+
+	// Pode ser chamado com as outras threads gravando; zonas sobrescritas durante a cópia são descartadas
+	bool writeChromeTrace(const char *path);
+
+private:
+	ProfileRing *addRing(const char *name);
+	ProfileRing *threadRing();
+
+	std::chrono::steady_clock::time_point origin;
+	std::atomic<bool> enabled;
+	std::mutex ringsLock; // só no registro de uma thread e no dump
+	std::vector<std::unique_ptr<ProfileRing>> rings;
+	ProfileRing *gpuRing;
+};
+
+extern Profiler profiler;
+
+class ProfileZone
+{
+public:
+	// Com o profiler desligado, nem o relógio é lido
+	explicit ProfileZone(const char *zoneName) : name(profiler.isEnabled() ? zoneName : nullptr), start(name ? profiler.now() : 0) {}
+	~ProfileZone()
+	{
+		if (name != nullptr)
+		{
+			profiler.record(name, start, profiler.now());
+		}
+	}
+	ProfileZone(const ProfileZone &) = delete;
+	ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+	const char *name;
+	int64_t start;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef PROFILER_ENABLED
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD(name) profiler.setThreadName(name)
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_THREAD(name)
+#endif
@@ -0,0 +1,44 @@
+// Contadores de renderização por frame: draws, instâncias, triângulos, binds, uniforms e bytes enviados
+// installRenderStats troca os ponteiros da GLAD das funções contadas (glDraw*, glBind*, glUseProgram,
+// glUniform*, glBufferData/SubData, glMapBufferRange, glTex(Sub)Image2D) por versões que somam no
+// frame atual e chamam a original. Nenhuma chamada do jogo muda: tudo que passa pela GLAD é contado.
+// Só a thread com o contexto de OpenGL chama OpenGL, então os contadores não são atômicos.
+//
+// Uso por frame: beginRenderStats(), desenho, endRenderStats(tempos). lastRenderStats() é o último
+// frame completo; pauseRenderStats deixa de fora o que não é do jogo (o próprio HUD, por exemplo).
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+struct RenderStats
+{
+	uint32_t drawCalls;
+	uint64_t instances;	 // 1 por draw não instanciado
+	uint64_t triangles;	 // primitivas de GL_TRIANGLES/STRIP/FAN vezes as instâncias
+	uint32_t textureBinds;
+	uint32_t bufferBinds;
+	uint32_t vertexArrayBinds;
+	uint32_t programBinds;
+	uint32_t uniformUploads; // chamadas glUniform*
+	uint64_t bytesUploaded;	 // glBufferData/SubData com dados, faixas mapeadas para escrita e texturas
+	double frameMs;			 // de um present ao seguinte
+	double cpuMs;			 // trabalho da thread de OpenGL, sem a espera do present
+	double gpuMs;			 // GL_TIME_ELAPSED do GpuProfiler, alguns frames atrasado (0 sem profiler)
+};
+
+// Depois do gladLoadGLLoader; chamar de novo não faz nada
+void installRenderStats();
+
+// Zera os contadores do frame atual
+void beginRenderStats();
+// Fecha o frame atual com os tempos medidos por quem chama; devolve o frame fechado
+const RenderStats &endRenderStats(double frameMs, double cpuMs, double gpuMs);
+// Enquanto pausado, as chamadas passam direto sem contar
+void pauseRenderStats(bool paused);
+
+const RenderStats &lastRenderStats();
+
+// Texto de várias linhas para o HUD ou o log; devolve o tamanho como snprintf
+int formatRenderStats(const RenderStats &stats, char *text, size_t size);
@@ -0,0 +1,160 @@
+// Scripts como corrotinas (C++20) resumidos em ticks fixos
+// Um script é uma função que retorna Script e usa co_await waitNextTick(), waitTicks(n) ou
+// event.wait(). O ScriptScheduler é dono dos scripts: a cada tick() ele resume os que acordaram,
+// na ordem em que foram agendados, e destrói os que terminaram. Esperas curtas ficam numa roda
+// de timers (O(1)); só as maiores que WHEEL_SIZE ticks passam por um heap.
+// Os frames das corrotinas vêm de um pool por thread com classes de tamanho de 64 bytes, então
+// criar e terminar scripts não passa pelo heap depois do aquecimento. Um script deve ser criado
+// e destruído na mesma thread (a do scheduler).
+
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
+
+class ScriptScheduler;
+class ScriptEvent;
+
+// Pool dos frames das corrotinas (por thread)
+void *scriptFrameAllocate(size_t size);
+void scriptFrameRelease(void *frame, size_t size);
+
+struct ScriptFrameStats
+{
+	uint64_t inUse;         // frames vivos vindos do pool
+	uint64_t reservedBytes; // memória reservada pelos blocos do pool
+	uint64_t heapFrames;    // frames grandes demais para o pool, alocados com new
+};
+ScriptFrameStats scriptFrameStats();
+
+class Script
+{
+public:
+	struct promise_type
+	{
+		ScriptScheduler *scheduler = nullptr;
+		promise_type *prev = nullptr; // lista dos scripts vivos do scheduler
+		promise_type *next = nullptr;
+		ScriptEvent *waitingOn = nullptr; // evento em que o script está suspenso, se houver
+
+		// Sai da lista de espera do evento: um frame destruído nunca é acordado
+		~promise_type();
+
+		Script get_return_object() { return Script(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		// Só começa a rodar no primeiro tick depois de spawn
+		std::suspend_always initial_suspend() noexcept { return {}; }
+		// Fica suspenso no fim para o scheduler ver done() e destruir
+		std::suspend_always final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+
+		static void *operator new(size_t size) { return scriptFrameAllocate(size); }
+		static void operator delete(void *frame, size_t size) { scriptFrameRelease(frame, size); }
+	};
+	typedef std::coroutine_handle<promise_type> Handle;
+
+	Script(Script &&other) noexcept : handle(other.handle) { other.handle = nullptr; }
+	Script(const Script &) = delete;
+	Script &operator=(const Script &) = delete;
+	Script &operator=(Script &&) = delete;
+	~Script()
+	{
+		if (handle)
+		{
+			handle.destroy();
+		}
+	}
+
+private:
+	friend class ScriptScheduler;
+	explicit Script(Handle h) : handle(h) {}
+	Handle handle;
+};
+
+class ScriptScheduler
+{
+public:
+	ScriptScheduler() : ticks(0), sequence(0), live(nullptr), liveCount(0) {}
+	ScriptScheduler(const ScriptScheduler &) = delete;
+	ScriptScheduler &operator=(const ScriptScheduler &) = delete;
+	~ScriptScheduler();
+
+	// Assume o script; ele roda pela primeira vez no próximo tick()
+	void spawn(Script script);
+	// Avança um tick: acorda os timers vencidos e resume os scripts prontos
+	void tick();
+
+	uint64_t currentTick() const { return ticks; }
+	uint32_t scriptCount() const { return liveCount; }
+
+	// Usados pelos awaitables
+	void wake(Script::Handle h) { ready.push_back(h); }
+	void sleep(Script::Handle h, uint32_t delay);
+
+private:
+	static const uint32_t WHEEL_SIZE = 256; // esperas menores que isso usam a roda, sem heap
+
+	struct Timer
+	{
+		uint64_t wakeTick;
+		uint64_t sequence; // desempate: mesma ordem de agendamento
+		Script::Handle handle;
+	};
+
+	uint64_t ticks;
+	uint64_t sequence;
+	std::vector<Script::Handle> ready;             // resumidos no próximo tick()
+	std::vector<Script::Handle> running;           // lote do tick atual
+	std::vector<Script::Handle> wheel[WHEEL_SIZE]; // slot (tick % WHEEL_SIZE): acordam nesse tick
+	std::vector<Timer> timers;                     // esperas longas: heap mínimo por wakeTick
+	Script::promise_type *live;
+	uint32_t liveCount;
+};
+
+// co_await waitTicks(n): resume n ticks depois; waitTicks(0) não suspende
+struct ScriptDelay
+{
+	uint32_t ticks;
+
+	bool await_ready() const noexcept { return ticks == 0; }
+	void await_suspend(Script::Handle h) const { h.promise().scheduler->sleep(h, ticks); }
+	void await_resume() const noexcept {}
+};
+
+inline ScriptDelay waitTicks(uint32_t ticks) { return ScriptDelay{ticks}; }
+inline ScriptDelay waitNextTick() { return ScriptDelay{1}; }
+
+// Evento sem estado: signal() acorda todos os scripts que estão esperando; eles rodam no próximo
+// tick() (ou ainda neste, se o sinal vier de fora do scheduler antes do tick). O evento deve
+// viver mais que os scripts que esperam nele; um script destruído enquanto espera (por exemplo, junto
+// com o scheduler) sai da lista sozinho.
+class ScriptEvent
+{
+public:
+	struct Awaiter
+	{
+		ScriptEvent &event;
+
+		bool await_ready() const noexcept { return false; }
+		void await_suspend(Script::Handle h) const
+		{
+			h.promise().waitingOn = &event;
+			event.waiters.push_back(h);
+		}
+		void await_resume() const noexcept {}
+	};
+
+	Awaiter wait() { return Awaiter{*this}; }
+	void signal();
+	size_t waiterCount() const { return waiters.size(); }
+
+private:
+	friend struct Script::promise_type;
+	void remove(Script::Handle h);
+
+	std::vector<Script::Handle> waiters;
+	std::vector<Script::Handle> signaled; // lote do signal() atual; trocado com waiters, sem alocar
+};
@@ -5,8 +5,8 @@
 
 #include <string>
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include "MemoryTracker.h"
 
 //GLAD
 #include <glad/glad.h>
@@ -24,33 +24,9 @@ public:
 	Shader(const GLchar* vertexPath, const GLchar* fragmentPath)
 	{
 		// 1. Retrieve the vertex/fragment source code from filePath
-		std::string vertexCode;
-		std::string fragmentCode;
-		std::ifstream vShaderFile;
-		std::ifstream fShaderFile;
-		// ensures ifstream objects can throw exceptions:
-		vShaderFile.exceptions(std::ifstream::badbit);
-		fShaderFile.exceptions(std::ifstream::badbit);
-		try
-		{
-			// Open files
-			vShaderFile.open(vertexPath);
-			fShaderFile.open(fragmentPath);
-			std::stringstream vShaderStream, fShaderStream;
-			// Read file's buffer contents into streams
-			vShaderStream << vShaderFile.rdbuf();
-			fShaderStream << fShaderFile.rdbuf();
-			// close file handlers
-			vShaderFile.close();
-			fShaderFile.close();
-			// Convert stream into string
-			vertexCode = vShaderStream.str();
-			fragmentCode = fShaderStream.str();
-		}
-		catch (std::ifstream::failure e)
-		{
-			std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ" << std::endl;
-		}
+		// (read straight into strings of the right size: no stringstream copy, counted under MemoryTag::Shaders)
+		TaggedString<MemoryTag::Shaders> vertexCode = readSource(vertexPath);
+		TaggedString<MemoryTag::Shaders> fragmentCode = readSource(fragmentPath);
 		const GLchar* vShaderCode = vertexCode.c_str();
 		const GLchar * fShaderCode = fragmentCode.c_str();
 		// 2. Compile shaders
@@ -102,6 +78,22 @@ public:
 		glUseProgram(this->ID);
 	}
 
+	// Reads the whole file; empty (and an error message) if it can't be opened
+	static TaggedString<MemoryTag::Shaders> readSource(const GLchar* path)
+	{
+		TaggedString<MemoryTag::Shaders> source;
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file)
+		{
+			std::cout << "ERROR::SHADER::FILE_NOT_SUCCESFULLY_READ: " << path << std::endl;
+			return source;
+		}
+		source.resize((size_t)file.tellg());
+		file.seekg(0);
+		file.read(&source[0], source.size());
+		return source;
+	}
+
 	void setBool(const std::string& name, bool value) const
 	{
 		glUniform1i(glGetUniformLocation(this->ID, name.c_str()), (int)value);
@@ -0,0 +1,9 @@
+// Compilação dos programas de shader usados pelos renderizadores de Common
+// Precisa do contexto de OpenGL atual.
+
+#pragma once
+
+#include <glad/glad.h>
+
+// Compila os dois estágios e linka o programa; devolve 0 se algo falhar, com o log no terminal
+GLuint buildProgram(const GLchar *vertexSource, const GLchar *fragmentSource);
@@ -0,0 +1,55 @@
+// Broadphase por grade uniforme
+// A grade é reconstruída a cada tick com um counting sort (contagem por célula, soma de
+// prefixos, preenchimento), em tempo linear no número de entidades. Cada AABB entra em
+// todas as células que cobre; caixas fora dos limites são presas às células da borda.
+// Os candidatos saem sem repetição e ainda precisam do teste fino (narrowphase).
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "AABBKernels.h"
+#include "MemoryTracker.h"
+
+struct CandidatePair
+{
+	uint32_t a, b; // a < b
+};
+
+class SpatialGrid
+{
+public:
+	SpatialGrid(float cellSize, float minX, float minY, float maxX, float maxY);
+
+	// As colunas precisam continuar válidas até a próxima chamada de build
+	void build(AABBColumns boxes, uint32_t count);
+
+	// Pares de entidades que dividem ao menos uma célula, cada par uma única vez
+	void findPairs(std::vector<CandidatePair> &pairs) const;
+
+	// Entidades que dividem ao menos uma célula com box; out precisa de espaço para count
+	// índices do último build. Retorna quantos foram gravados.
+	uint32_t query(AABB box, uint32_t *out) const;
+
+	uint32_t cellCount() const { return cellsX * cellsY; }
+	uint32_t entryCount() const { return (uint32_t)entries.size(); }
+
+private:
+	struct CellRange
+	{
+		uint32_t x0, y0, x1, y1;
+	};
+
+	uint32_t cellX(float x) const;
+	uint32_t cellY(float y) const;
+	CellRange rangeOf(float minX, float minY, float maxX, float maxY) const;
+
+	float originX, originY, invCellSize;
+	uint32_t cellsX, cellsY;
+
+	AABBColumns boxes;
+	uint32_t count;
+	TaggedVector<uint32_t, MemoryTag::Spatial> cellStart;  // células c ocupam entries[cellStart[c], cellStart[c + 1])
+	TaggedVector<uint32_t, MemoryTag::Spatial> cellCursor; // usado só durante o preenchimento
+	TaggedVector<uint32_t, MemoryTag::Spatial> entries;
+};
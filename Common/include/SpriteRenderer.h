@@ -0,0 +1,43 @@
+// Desenho instanciado dos sprites: um quad compartilhado e um buffer de instâncias reescrito a cada frame
+// draw gera as instâncias nos workers (InstanceBuilder) direto no buffer mapeado e faz um
+// glDrawArraysInstanced por camada, na ordem das camadas, com a textura daquela camada.
+// Não depende de janela: roda igual no contexto da GLFW e num contexto headless (HeadlessContext.h).
+// rotation escolhe o formato da instância (Transform2D.h) e o vertex shader correspondente: sem
+// rotação, o ângulo dos sprites é ignorado e nenhum seno ou cosseno é calculado.
+// Só a thread com o contexto de OpenGL usa o renderer.
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include "InstanceBuilder.h"
+#include "JobSystem.h"
+
+class SpriteRenderer
+{
+public:
+	SpriteRenderer(uint32_t layerCount, uint32_t maxInstances, bool rotation = false);
+
+	// Compila o shader e cria os buffers; precisa do contexto atual
+	bool init();
+	void shutdown();
+
+	// Matriz 4x4 em colunas, como value_ptr da glm
+	void setProjection(const float *matrix);
+
+	// count <= capacity(); layerTextures tem uma textura por camada. Sprites além da capacidade não são desenhados
+	void draw(JobSystem &jobs, const InstanceSprite *sprites, uint32_t count, const GLuint *layerTextures);
+
+	uint32_t capacity() const { return maxInstances; }
+	bool rotates() const { return rotation; }
+
+private:
+	void bindInstanceAttributes(uint32_t firstInstance);
+
+	uint32_t maxInstances;
+	bool rotation;
+	size_t instanceSize; // sizeof(SpriteInstance<rotation>)
+	InstanceBuilder builder;
+	GLuint program, vao, quadVBO, instanceVBO;
+	GLint projectionLocation;
+};
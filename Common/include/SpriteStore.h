@@ -0,0 +1,62 @@
+// Armazenamento structure-of-arrays (SoA) das entidades de sprite
+// Cada atributo fica num array contíguo próprio, indexado pelo índice denso do EntityPool,
+// para que cada sistema (movimento, AABB, animação, desenho) leia só as colunas que usa.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "EntityPool.h"
+#include "AABBKernels.h"
+#include "MemoryTracker.h"
+
+class SpriteStore
+{
+public:
+	SpriteStore(uint32_t capacity);
+
+	// A entidade nova ocupa o índice denso size() - 1, com todas as colunas zeradas
+	EntityHandle spawn();
+	// O último elemento denso é movido para o buraco em todas as colunas
+	bool despawn(EntityHandle handle);
+
+	uint32_t size() const { return pool.size(); }
+	uint32_t capacity() const { return pool.capacity(); }
+	bool isAlive(EntityHandle handle) const { return pool.isAlive(handle); }
+	uint32_t denseIndex(EntityHandle handle) const { return pool.denseIndex(handle); }
+	EntityHandle handleAt(uint32_t dense) const { return pool.handleAt(dense); }
+
+	AABBColumns aabbColumns() const
+	{
+		AABBColumns columns = { minX.data(), minY.data(), maxX.data(), maxY.data() };
+		return columns;
+	}
+
+	// Colunas contadas na tag Sprites do MemoryTracker
+	using FloatColumn = TaggedVector<float, MemoryTag::Sprites>;
+	using IntColumn = TaggedVector<int32_t, MemoryTag::Sprites>;
+
+	// Posição (centro do sprite)
+	FloatColumn posX, posY;
+	// Velocidade por frame
+	FloatColumn velX, velY;
+	// Metade das dimensões
+	FloatColumn halfW, halfH;
+	// AABB (Axis Aligned Bounding Box), recalculada por buildAABBs
+	FloatColumn minX, minY, maxX, maxY;
+	// Estado da animação da spritesheet
+	IntColumn iAnimation, iFrame;
+	// Id do protótipo que guarda VAO, textura e efeito
+	IntColumn renderID;
+
+private:
+	EntityPool pool;
+};
+
+// Sistemas: cada um percorre só as colunas necessárias, para [first, last)
+void integrateMotion(SpriteStore &store, uint32_t first, uint32_t last);
+void buildAABBs(SpriteStore &store, uint32_t first, uint32_t last);
+void advanceFrames(SpriteStore &store, const int32_t *nFramesByRenderID, uint32_t first, uint32_t last);
+
+inline void integrateMotion(SpriteStore &store) { integrateMotion(store, 0, store.size()); }
+inline void buildAABBs(SpriteStore &store) { buildAABBs(store, 0, store.size()); }
@@ -0,0 +1,61 @@
+// Fila sem lock de um produtor e um consumidor (SPSC), com capacidade fixa
+// Cada índice só é escrito por um dos lados; o outro só lê, então basta acquire/release.
+// push falha com a fila cheia em vez de bloquear.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+template <class T, uint32_t CAPACITY>
+class SpscQueue
+{
+	static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY precisa ser potência de 2");
+
+public:
+	SpscQueue() : head(0), tail(0) {}
+	SpscQueue(const SpscQueue &) = delete;
+	SpscQueue &operator=(const SpscQueue &) = delete;
+
+	// Lado do produtor
+	bool push(const T &item)
+	{
+		uint32_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) == CAPACITY)
+		{
+			return false;
+		}
+		items[t & (CAPACITY - 1)] = item;
+		tail.store(t + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Lado do consumidor
+	bool peek(T &item) const
+	{
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		item = items[h & (CAPACITY - 1)];
+		return true;
+	}
+
+	bool pop(T &item)
+	{
+		uint32_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+		item = items[h & (CAPACITY - 1)];
+		head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+	alignas(64) std::atomic<uint32_t> head; // próximo a ler (consumidor)
+	alignas(64) std::atomic<uint32_t> tail; // próximo a escrever (produtor)
+	T items[CAPACITY];
+};
@@ -0,0 +1,38 @@
+// Colisão contínua (swept AABB) de um lote de itens contra uma caixa alvo
+// Cada item percorre o segmento pos -> pos + vel durante o tick. A caixa alvo é expandida
+// pela meia-extensão do item (soma de Minkowski) e o centro do item vira um raio, testado
+// pelo método dos slabs. Um item rápido que atravessaria o alvo entre dois frames ainda
+// colide, no instante de impacto (TOI) em [0, 1].
+// Usa o mesmo caminho SIMD dos kernels de AABB (AVX2, SSE ou escalar).
+
+#pragma once
+
+#include <cstdint>
+#include "AABBKernels.h"
+
+// Colunas SoA do lote varrido (centro, meia-extensão e deslocamento no tick)
+struct SweptBatch
+{
+	const float *posX, *posY, *halfW, *halfH, *velX, *velY;
+};
+
+struct SweptHit
+{
+	uint32_t index; // índice no lote, ou NO_SWEPT_HIT
+	float toi;		// instante do contato dentro do tick, em [0, 1]
+};
+
+const uint32_t NO_SWEPT_HIT = 0xFFFFFFFFu;
+
+// Instante de impacto de um único item; retorna false se não há contato no tick.
+// (targetDX, targetDY) é o deslocamento do alvo no mesmo tick: o teste usa o movimento relativo.
+bool sweptTOI(AABB target, float targetDX, float targetDY, float posX, float posY, float halfW, float halfH,
+			  float velX, float velY, float &toi);
+
+// Testa o lote inteiro; grava os índices atingidos (crescentes) em hits e o TOI de cada um em
+// hitTimes. Os dois precisam de espaço para count elementos. Retorna o número de contatos.
+uint32_t sweepAgainstBox(AABB target, float targetDX, float targetDY, SweptBatch items, uint32_t count,
+						 uint32_t *hits, float *hitTimes);
+
+// O contato mais cedo entre os encontrados por sweepAgainstBox
+SweptHit earliestHit(const uint32_t *hits, const float *hitTimes, uint32_t n);
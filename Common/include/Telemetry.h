@@ -0,0 +1,100 @@
+// Telemetria por frame em disco, para análise offline de sessões longas
+// Cada frame (tempos, draws, entidades) e cada evento do jogo (pontuação, vidas, onda, game over)
+// vira um registro binário de tamanho fixo. Quem grava só copia o registro para uma fila sem lock
+// (SpscQueue); uma thread de fundo junta os registros em lotes e escreve com fwrite, então o custo
+// no frame é o de uma cópia de 48 bytes e uma leitura do relógio. Com a fila cheia o registro é
+// descartado e contado, nunca bloqueia.
+// São duas filas de um produtor: recordFrame só da thread de OpenGL, recordEvent só da simulação.
+// No arquivo os registros saem em lotes, não em ordem global: ordene por timeNs se precisar.
+//
+// Arquivo: TelemetryHeader e depois os registros como estão na memória (little-endian).
+// telemetryToCsv converte para uma linha por registro (ferramenta: Benchmarks/TelemetryToCsv).
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include "SpscQueue.h"
+
+enum TelemetryKind : uint16_t
+{
+	TELEMETRY_FRAME,
+	TELEMETRY_SCORE,
+	TELEMETRY_LIVES,
+	TELEMETRY_WAVE,
+	TELEMETRY_GAMEOVER
+};
+
+struct TelemetryRecord
+{
+	uint64_t timeNs; // desde o start()
+	uint32_t frame;	 // frames gravados até aqui
+	uint16_t kind;	 // TelemetryKind
+	uint16_t session; // gravação (start) que gerou o registro; o escritor descarta as de outra
+	// TELEMETRY_FRAME
+	float frameMs;	// de um present ao seguinte
+	float simMs;	// trabalho do tick da simulação que gerou o snapshot
+	float renderMs; // trabalho da thread de OpenGL
+	float gpuMs;
+	uint32_t drawCalls;
+	uint32_t instances;
+	uint32_t entities;
+	// Eventos: o novo valor (pontuação, vidas, número da onda)
+	int32_t value;
+};
+static_assert(sizeof(TelemetryRecord) == 48, "o formato do arquivo depende do tamanho do registro");
+
+struct TelemetryHeader
+{
+	char magic[8]; // "PGTELEM"
+	uint32_t version;
+	uint32_t recordSize;
+};
+
+class Telemetry
+{
+public:
+	static const uint32_t CAPACITY = 4096; // registros por fila: pouco mais de 1 minuto de frames a 60 Hz
+	static const uint32_t VERSION = 1;
+
+	Telemetry() = default;
+	~Telemetry();
+	Telemetry(const Telemetry &) = delete;
+	Telemetry &operator=(const Telemetry &) = delete;
+
+	// Abre (trunca) o arquivo e inicia a thread de escrita; false se não abrir ou já estiver gravando
+	bool start(const char *path);
+	// Escreve o que está nas filas e fecha o arquivo
+	void stop();
+	bool recording() const { return active.load(std::memory_order_relaxed); }
+
+	// Só preenche os campos de frame; timeNs, frame e kind são do gravador
+	void recordFrame(const TelemetryRecord &frame);
+	void recordEvent(TelemetryKind kind, int32_t value);
+
+	uint64_t recordCount() const { return written.load(std::memory_order_relaxed); }
+	uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+	void writerLoop(uint16_t current);
+	uint32_t drain(TelemetryRecord *batch, uint32_t size, uint16_t current);
+	void stamp(TelemetryRecord &record) const; // tempo e sessão
+
+	SpscQueue<TelemetryRecord, CAPACITY> frames;
+	SpscQueue<TelemetryRecord, CAPACITY> events;
+	std::atomic<bool> active{false};
+	std::atomic<bool> running{false};
+	std::atomic<uint32_t> frameCount{0};
+	std::atomic<uint64_t> written{0};
+	std::atomic<uint64_t> dropped{0};
+	std::atomic<uint32_t> session{0};
+	std::atomic<int64_t> startNs{0}; // instante do start() em ns do steady_clock; lido pelas threads que gravam
+	FILE *file = nullptr;
+	std::thread writer;
+};
+
+// Uma linha por registro; colunas de frame vazias nos eventos e vice-versa. false se não ler/escrever
+bool telemetryToCsv(const char *binaryPath, const char *csvPath);
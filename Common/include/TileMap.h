@@ -0,0 +1,76 @@
+// Tilemap em chunks, com um VBO estático por chunk
+// Cada camada é uma grade width x height de tiles; um tile é um índice no atlas (uma textura dividida
+// em colunas x linhas de células iguais), com EMPTY_TILE para vazio. A grade é dividida em chunks de
+// TILE_CHUNK_SIZE x TILE_CHUNK_SIZE tiles e cada chunk guarda os quads dos seus tiles não vazios num
+// VBO GL_STATIC_DRAW, com as UVs do atlas já resolvidas; o buffer de índices é um só, compartilhado.
+// setTile só marca o chunk como sujo: o VBO é refeito no próximo draw em que o chunk aparecer.
+// draw faz um glDrawElements por chunk não vazio que cruza a área visível, camada por camada, então
+// um mapa grande custa os poucos chunks da tela, qualquer que seja o número de tiles.
+// O tile (x, y) cobre [x, x + 1) * tileSize nos dois eixos, com y para cima, como a projeção do jogo.
+// Só a thread com o contexto de OpenGL usa o TileMap.
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include "MemoryTracker.h"
+
+const uint32_t TILE_CHUNK_SIZE = 32; // 32 * 32 quads de 4 vértices cabem em índices de 16 bits
+const uint16_t EMPTY_TILE = 0;
+
+class TileMap
+{
+public:
+	TileMap(uint32_t width, uint32_t height, uint32_t layerCount, float tileSize);
+
+	// Compila o shader e cria o buffer de índices; precisa do contexto atual
+	bool init();
+	void shutdown();
+
+	// Matriz 4x4 em colunas, como value_ptr da glm
+	void setProjection(const float *matrix);
+
+	// O tile t (1 a columns * rows) usa a célula t - 1, da esquerda para a direita e de cima para baixo.
+	// Trocar o atlas refaz todos os chunks.
+	void setAtlas(GLuint texture, uint32_t columns, uint32_t rows);
+
+	// Fora do mapa, setTile não faz nada e tile devolve EMPTY_TILE
+	void setTile(uint32_t layer, uint32_t x, uint32_t y, uint16_t tile);
+	uint16_t tile(uint32_t layer, uint32_t x, uint32_t y) const;
+
+	// Área visível em coordenadas do mundo; devolve o número de draws
+	uint32_t draw(float minX, float minY, float maxX, float maxY);
+
+	uint32_t width() const { return mapWidth; }
+	uint32_t height() const { return mapHeight; }
+	uint32_t layerCount() const { return layers; }
+	float tileSize() const { return size; }
+	uint32_t chunkCount() const { return (uint32_t)chunks.size(); }
+	uint32_t rebuildCount() const { return rebuilds; } // chunks refeitos desde a criação
+
+private:
+	struct Chunk
+	{
+		GLuint vao, vbo; // criados no primeiro rebuild
+		uint32_t quadCount;
+		bool dirty;
+	};
+
+	Chunk &chunkAt(uint32_t layer, uint32_t cx, uint32_t cy) { return chunks[(layer * chunksY + cy) * chunksX + cx]; }
+	void rebuildChunk(Chunk &chunk, uint32_t layer, uint32_t cx, uint32_t cy);
+
+	uint32_t mapWidth, mapHeight, layers;
+	float size;
+	uint32_t chunksX, chunksY;
+	TaggedVector<uint16_t, MemoryTag::Tiles> tiles; // por camada, linha a linha a partir de y = 0
+	TaggedVector<Chunk, MemoryTag::Tiles> chunks;
+	TaggedVector<float, MemoryTag::Tiles> vertices; // rascunho do rebuild: x, y, u, v por vértice
+	uint32_t rebuilds;
+
+	GLuint atlas;
+	uint32_t atlasColumns, atlasRows;
+	float texelU, texelV; // meio texel do atlas, para a amostragem não vazar para a célula vizinha
+
+	GLuint program, indexBuffer;
+	GLint projectionLocation;
+};
@@ -0,0 +1,53 @@
+// Transformação afim 2D compacta: p' = translação + M * p
+// Transform2D<false> é só escala e translação (4 floats) e nunca calcula seno nem cosseno.
+// Transform2D<true> guarda a matriz 2x3 (colunas da 2x2 rotação * escala e a translação, 6 floats).
+// A escolha é em tempo de compilação, no tipo: quem não gira sprites (o jogo) não paga a
+// trigonometria nem os floats a mais em cada instância. Os campos estão na ordem que o vertex
+// shader do SpriteRenderer lê.
+
+#pragma once
+
+#include <cmath>
+
+template <bool Rotates>
+struct Transform2D;
+
+template <>
+struct Transform2D<false>
+{
+	float translation[2];
+	float scale[2];
+
+	// angle é ignorado: o tipo sem rotação existe justamente para não olhar para ele
+	static Transform2D make(float x, float y, float width, float height, float angle = 0.0f)
+	{
+		(void)angle;
+		return { { x, y }, { width, height } };
+	}
+
+	void apply(float &x, float &y) const
+	{
+		x = translation[0] + scale[0] * x;
+		y = translation[1] + scale[1] * y;
+	}
+};
+
+template <>
+struct Transform2D<true>
+{
+	float basis[4]; // colunas da matriz 2x2
+	float translation[2];
+
+	static Transform2D make(float x, float y, float width, float height, float angle)
+	{
+		float c = std::cos(angle), s = std::sin(angle);
+		return { { c * width, s * width, -s * height, c * height }, { x, y } };
+	}
+
+	void apply(float &x, float &y) const
+	{
+		float px = x;
+		x = translation[0] + basis[0] * px + basis[2] * y;
+		y = translation[1] + basis[1] * px + basis[3] * y;
+	}
+};
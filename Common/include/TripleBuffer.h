@@ -0,0 +1,49 @@
+// Buffer triplo sem lock entre um produtor e um consumidor
+// O produtor escreve sempre no seu slot (writeBuffer) e o publica com publish; o consumidor pega
+// o último publicado com acquire e lê readBuffer. O terceiro slot fica no meio, trocado com uma
+// única operação atômica, então nenhum dos lados espera o outro e um slot publicado não é mais
+// alterado até voltar para o produtor.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+template <class T>
+class TripleBuffer
+{
+public:
+	TripleBuffer() : shared(1), back(0), front(2) {}
+	TripleBuffer(const TripleBuffer &) = delete;
+	TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+	// Lado do produtor
+	T &writeBuffer() { return slots[back]; }
+	void publish()
+	{
+		uint8_t old = shared.exchange(back | FRESH, std::memory_order_acq_rel);
+		back = old & INDEX_MASK;
+	}
+
+	// Lado do consumidor: retorna true se havia um slot novo; senão readBuffer continua o mesmo
+	bool acquire()
+	{
+		if (!(shared.load(std::memory_order_relaxed) & FRESH))
+		{
+			return false;
+		}
+		uint8_t old = shared.exchange(front, std::memory_order_acq_rel);
+		front = old & INDEX_MASK;
+		return true;
+	}
+	const T &readBuffer() const { return slots[front]; }
+
+private:
+	static const uint8_t INDEX_MASK = 0x3;
+	static const uint8_t FRESH = 0x4; // o slot do meio ainda não foi lido
+
+	T slots[3];
+	alignas(64) std::atomic<uint8_t> shared; // índice do slot do meio + FRESH
+	alignas(64) uint8_t back;				 // só o produtor usa
+	alignas(64) uint8_t front;				 // só o consumidor usa
+};
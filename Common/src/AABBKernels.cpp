@@ -0,0 +1,228 @@
+#include "AABBKernels.h"
+
+#include <cstring>
+
+#if !defined(AABB_KERNELS_SCALAR) && defined(__AVX2__)
+#define AABB_KERNELS_AVX2
+#include <immintrin.h>
+#elif !defined(AABB_KERNELS_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define AABB_KERNELS_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	inline uint32_t lowestBit(uint32_t bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, bits);
+		return (uint32_t)index;
+#else
+		return (uint32_t)__builtin_ctz(bits);
+#endif
+	}
+
+	// Grava em hits os índices base + i de cada bit ligado em laneBits
+	inline uint32_t emitIndices(uint32_t laneBits, uint32_t base, uint32_t *hits, uint32_t n)
+	{
+		while (laneBits)
+		{
+			hits[n++] = base + lowestBit(laneBits);
+			laneBits &= laneBits - 1;
+		}
+		return n;
+	}
+
+	inline bool overlapsAt(const AABB &box, const AABBColumns &boxes, uint32_t i)
+	{
+		return box.maxX >= boxes.minX[i] && boxes.maxX[i] >= box.minX && box.maxY >= boxes.minY[i] && boxes.maxY[i] >= box.minY;
+	}
+
+#if defined(AABB_KERNELS_AVX2)
+	const uint32_t WIDTH = 8;
+
+	inline uint32_t laneMask(const AABB &box, const AABBColumns &boxes, uint32_t i)
+	{
+		__m256 hit = _mm256_cmp_ps(_mm256_set1_ps(box.maxX), _mm256_loadu_ps(boxes.minX + i), _CMP_GE_OQ);
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(boxes.maxX + i), _mm256_set1_ps(box.minX), _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_set1_ps(box.maxY), _mm256_loadu_ps(boxes.minY + i), _CMP_GE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_loadu_ps(boxes.maxY + i), _mm256_set1_ps(box.minY), _CMP_GE_OQ));
+		return (uint32_t)_mm256_movemask_ps(hit);
+	}
+#elif defined(AABB_KERNELS_SSE)
+	const uint32_t WIDTH = 4;
+
+	inline uint32_t laneMask(const AABB &box, const AABBColumns &boxes, uint32_t i)
+	{
+		__m128 hit = _mm_cmpge_ps(_mm_set1_ps(box.maxX), _mm_loadu_ps(boxes.minX + i));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_loadu_ps(boxes.maxX + i), _mm_set1_ps(box.minX)));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_set1_ps(box.maxY), _mm_loadu_ps(boxes.minY + i)));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(_mm_loadu_ps(boxes.maxY + i), _mm_set1_ps(box.minY)));
+		return (uint32_t)_mm_movemask_ps(hit);
+	}
+#else
+	const uint32_t WIDTH = 1;
+
+	inline uint32_t laneMask(const AABB &box, const AABBColumns &boxes, uint32_t i)
+	{
+		return overlapsAt(box, boxes, i) ? 1u : 0u;
+	}
+#endif
+}
+
+const char *aabbKernelPath()
+{
+#if defined(AABB_KERNELS_AVX2)
+	return "AVX2";
+#elif defined(AABB_KERNELS_SSE)
+	return "SSE";
+#else
+	return "escalar";
+#endif
+}
+
+void buildAABBBatchScalar(const float *posX, const float *posY, const float *halfW, const float *halfH,
+						  float *minX, float *minY, float *maxX, float *maxY, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		minX[i] = posX[i] - halfW[i];
+		minY[i] = posY[i] - halfH[i];
+		maxX[i] = posX[i] + halfW[i];
+		maxY[i] = posY[i] + halfH[i];
+	}
+}
+
+void buildAABBBatch(const float *posX, const float *posY, const float *halfW, const float *halfH,
+					float *minX, float *minY, float *maxX, float *maxY, uint32_t count)
+{
+	uint32_t i = 0;
+#if defined(AABB_KERNELS_AVX2)
+	for (; i + 8 <= count; i += 8)
+	{
+		__m256 x = _mm256_loadu_ps(posX + i), y = _mm256_loadu_ps(posY + i);
+		__m256 w = _mm256_loadu_ps(halfW + i), h = _mm256_loadu_ps(halfH + i);
+		_mm256_storeu_ps(minX + i, _mm256_sub_ps(x, w));
+		_mm256_storeu_ps(minY + i, _mm256_sub_ps(y, h));
+		_mm256_storeu_ps(maxX + i, _mm256_add_ps(x, w));
+		_mm256_storeu_ps(maxY + i, _mm256_add_ps(y, h));
+	}
+#elif defined(AABB_KERNELS_SSE)
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(posX + i), y = _mm_loadu_ps(posY + i);
+		__m128 w = _mm_loadu_ps(halfW + i), h = _mm_loadu_ps(halfH + i);
+		_mm_storeu_ps(minX + i, _mm_sub_ps(x, w));
+		_mm_storeu_ps(minY + i, _mm_sub_ps(y, h));
+		_mm_storeu_ps(maxX + i, _mm_add_ps(x, w));
+		_mm_storeu_ps(maxY + i, _mm_add_ps(y, h));
+	}
+#endif
+	buildAABBBatchScalar(posX + i, posY + i, halfW + i, halfH + i, minX + i, minY + i, maxX + i, maxY + i, count - i);
+}
+
+uint32_t overlapOneVsMany(AABB box, AABBColumns boxes, uint32_t count, uint64_t *mask)
+{
+	memset(mask, 0, ((count + 63) / 64) * sizeof(uint64_t));
+
+	uint32_t hits = 0;
+	uint32_t i = 0;
+	// WIDTH divide 64, então um bloco nunca atravessa duas palavras da máscara
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		uint32_t lanes = laneMask(box, boxes, i);
+		if (lanes)
+		{
+			mask[i / 64] |= (uint64_t)lanes << (i % 64);
+			for (uint32_t bits = lanes; bits; bits &= bits - 1)
+			{
+				hits++;
+			}
+		}
+	}
+	for (; i < count; i++)
+	{
+		if (overlapsAt(box, boxes, i))
+		{
+			mask[i / 64] |= (uint64_t)1 << (i % 64);
+			hits++;
+		}
+	}
+	return hits;
+}
+
+uint32_t overlapOneVsManyIndicesScalar(AABB box, AABBColumns boxes, uint32_t count, uint32_t *hits)
+{
+	uint32_t n = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (overlapsAt(box, boxes, i))
+		{
+			hits[n++] = i;
+		}
+	}
+	return n;
+}
+
+uint32_t overlapOneVsManyIndices(AABB box, AABBColumns boxes, uint32_t count, uint32_t *hits)
+{
+	uint32_t n = 0;
+	uint32_t i = 0;
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		uint32_t lanes = laneMask(box, boxes, i);
+		if (lanes)
+		{
+			n = emitIndices(lanes, i, hits, n);
+		}
+	}
+	for (; i < count; i++)
+	{
+		if (overlapsAt(box, boxes, i))
+		{
+			hits[n++] = i;
+		}
+	}
+	return n;
+}
+
+uint32_t overlapManyVsMany(AABBColumns a, uint32_t countA, AABBColumns b, uint32_t countB,
+						   uint32_t *pairsA, uint32_t *pairsB, uint32_t maxPairs)
+{
+	uint32_t total = 0;
+	for (uint32_t j = 0; j < countA; j++)
+	{
+		AABB box = { a.minX[j], a.minY[j], a.maxX[j], a.maxY[j] };
+		uint32_t i = 0;
+		for (; i + WIDTH <= countB; i += WIDTH)
+		{
+			for (uint32_t lanes = laneMask(box, b, i); lanes; lanes &= lanes - 1)
+			{
+				if (total < maxPairs)
+				{
+					pairsA[total] = j;
+					pairsB[total] = i + lowestBit(lanes);
+				}
+				total++;
+			}
+		}
+		for (; i < countB; i++)
+		{
+			if (overlapsAt(box, b, i))
+			{
+				if (total < maxPairs)
+				{
+					pairsA[total] = j;
+					pairsB[total] = i;
+				}
+				total++;
+			}
+		}
+	}
+	return total;
+}
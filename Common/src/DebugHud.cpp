@@ -0,0 +1,281 @@
+#include "DebugHud.h"
+
+#include <cstddef>
+#include "ShaderUtil.h"
+
+namespace
+{
+	const int GLYPH_WIDTH = 5, GLYPH_HEIGHT = 7;
+	const int CELL_WIDTH = 6, CELL_HEIGHT = 8; // glifo mais um pixel de espaço
+	const char FIRST_CHAR = ' ', LAST_CHAR = 'Z';
+	const int NUM_GLYPHS = LAST_CHAR - FIRST_CHAR + 1;
+	const int SOLID_GLYPH = NUM_GLYPHS; // célula toda acesa, usada pelo painel
+	const uint32_t PANEL_COLOR = 0xB0000000;
+	const float PANEL_MARGIN = 4.0f;
+
+	// Uma coluna por byte, bit 0 em cima
+	const uint8_t FONT[NUM_GLYPHS][GLYPH_WIDTH] = {
+		{0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+		{0x00, 0x00, 0x5F, 0x00, 0x00}, // !
+		{0x00, 0x07, 0x00, 0x07, 0x00}, // "
+		{0x14, 0x7F, 0x14, 0x7F, 0x14}, // #
+		{0x24, 0x2A, 0x7F, 0x2A, 0x12}, // $
+		{0x23, 0x13, 0x08, 0x64, 0x62}, // %
+		{0x36, 0x49, 0x56, 0x20, 0x50}, // &
+		{0x00, 0x00, 0x07, 0x00, 0x00}, // '
+		{0x00, 0x1C, 0x22, 0x41, 0x00}, // (
+		{0x00, 0x41, 0x22, 0x1C, 0x00}, // )
+		{0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, // *
+		{0x08, 0x08, 0x3E, 0x08, 0x08}, // +
+		{0x00, 0x40, 0x30, 0x00, 0x00}, // ,
+		{0x08, 0x08, 0x08, 0x08, 0x08}, // -
+		{0x00, 0x60, 0x60, 0x00, 0x00}, // .
+		{0x20, 0x10, 0x08, 0x04, 0x02}, // /
+		{0x3E, 0x51, 0x49, 0x45, 0x3E}, // 0
+		{0x00, 0x42, 0x7F, 0x40, 0x00}, // 1
+		{0x62, 0x51, 0x49, 0x49, 0x46}, // 2
+		{0x22, 0x41, 0x49, 0x49, 0x36}, // 3
+		{0x18, 0x14, 0x12, 0x7F, 0x10}, // 4
+		{0x27, 0x45, 0x45, 0x45, 0x39}, // 5
+		{0x3C, 0x4A, 0x49, 0x49, 0x30}, // 6
+		{0x01, 0x71, 0x09, 0x05, 0x03}, // 7
+		{0x36, 0x49, 0x49, 0x49, 0x36}, // 8
+		{0x06, 0x49, 0x49, 0x29, 0x1E}, // 9
+		{0x00, 0x36, 0x36, 0x00, 0x00}, // :
+		{0x00, 0x56, 0x36, 0x00, 0x00}, // ;
+		{0x08, 0x14, 0x22, 0x41, 0x00}, // <
+		{0x14, 0x14, 0x14, 0x14, 0x14}, // =
+		{0x00, 0x41, 0x22, 0x14, 0x08}, // >
+		{0x02, 0x01, 0x51, 0x09, 0x06}, // ?
+		{0x3E, 0x41, 0x5D, 0x55, 0x1E}, // @
+		{0x7E, 0x09, 0x09, 0x09, 0x7E}, // A
+		{0x7F, 0x49, 0x49, 0x49, 0x36}, // B
+		{0x3E, 0x41, 0x41, 0x41, 0x22}, // C
+		{0x7F, 0x41, 0x41, 0x22, 0x1C}, // D
+		{0x7F, 0x49, 0x49, 0x49, 0x41}, // E
+		{0x7F, 0x09, 0x09, 0x09, 0x01}, // F
+		{0x3E, 0x41, 0x49, 0x49, 0x7A}, // G
+		{0x7F, 0x08, 0x08, 0x08, 0x7F}, // H
+		{0x00, 0x41, 0x7F, 0x41, 0x00}, // I
+		{0x20, 0x40, 0x41, 0x3F, 0x01}, // J
+		{0x7F, 0x08, 0x14, 0x22, 0x41}, // K
+		{0x7F, 0x40, 0x40, 0x40, 0x40}, // L
+		{0x7F, 0x02, 0x0C, 0x02, 0x7F}, // M
+		{0x7F, 0x04, 0x08, 0x10, 0x7F}, // N
+		{0x3E, 0x41, 0x41, 0x41, 0x3E}, // O
+		{0x7F, 0x09, 0x09, 0x09, 0x06}, // P
+		{0x3E, 0x41, 0x51, 0x21, 0x5E}, // Q
+		{0x7F, 0x09, 0x19, 0x29, 0x46}, // R
+		{0x46, 0x49, 0x49, 0x49, 0x31}, // S
+		{0x01, 0x01, 0x7F, 0x01, 0x01}, // T
+		{0x3F, 0x40, 0x40, 0x40, 0x3F}, // U
+		{0x1F, 0x20, 0x40, 0x20, 0x1F}, // V
+		{0x3F, 0x40, 0x38, 0x40, 0x3F}, // W
+		{0x63, 0x14, 0x08, 0x14, 0x63}, // X
+		{0x07, 0x08, 0x70, 0x08, 0x07}, // Y
+		{0x61, 0x51, 0x49, 0x45, 0x43}, // Z
+	};
+
+	const GLchar *VERTEX_SHADER = R"(
+		#version 400
+		layout (location = 0) in vec2 position;	// pixels, origem em cima à esquerda
+		layout (location = 1) in vec2 uv;
+		layout (location = 2) in vec4 color;
+		uniform vec2 viewport;
+		out vec2 glyphCoord;
+		out vec4 textColor;
+		void main() {
+			gl_Position = vec4(2.0 * position.x / viewport.x - 1.0, 1.0 - 2.0 * position.y / viewport.y, 0.0, 1.0);
+			glyphCoord = uv;
+			textColor = color;
+		}
+	)";
+
+	const GLchar *FRAGMENT_SHADER = R"(
+		#version 400
+		in vec2 glyphCoord;
+		in vec4 textColor;
+		uniform sampler2D font;
+		out vec4 color;
+		void main() { color = vec4(textColor.rgb, textColor.a * texture(font, glyphCoord).r); }
+	)";
+}
+
+DebugHud::DebugHud() : program(0), vao(0), vbo(0), fontTexture(0), viewportLocation(-1), scale(2.0f), ready(false),
+					   minX(0.0f), minY(0.0f), maxX(0.0f), maxY(0.0f)
+{
+}
+
+bool DebugHud::init(float pixelScale)
+{
+	scale = pixelScale;
+
+	program = buildProgram(VERTEX_SHADER, FRAGMENT_SHADER);
+	if (program == 0)
+	{
+		return false;
+	}
+	viewportLocation = glGetUniformLocation(program, "viewport");
+
+	GLint previousProgram, previousTexture;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "font"), 0);
+	glUseProgram(previousProgram);
+
+	// Fonte: as células lado a lado numa linha, mais a célula sólida no fim
+	const int textureWidth = (NUM_GLYPHS + 1) * CELL_WIDTH;
+	std::vector<uint8_t> pixels(textureWidth * CELL_HEIGHT, 0);
+	for (int glyph = 0; glyph <= NUM_GLYPHS; glyph++)
+	{
+		for (int column = 0; column < CELL_WIDTH; column++)
+		{
+			uint8_t bits = glyph == SOLID_GLYPH ? 0xFF : column < GLYPH_WIDTH ? FONT[glyph][column] : 0;
+			for (int row = 0; row < (glyph == SOLID_GLYPH ? CELL_HEIGHT : GLYPH_HEIGHT); row++)
+			{
+				if (bits & (1 << row))
+				{
+					pixels[row * textureWidth + glyph * CELL_WIDTH + column] = 0xFF;
+				}
+			}
+		}
+	}
+	glGenTextures(1, &fontTexture);
+	glBindTexture(GL_TEXTURE_2D, fontTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, textureWidth, CELL_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glBindTexture(GL_TEXTURE_2D, previousTexture);
+
+	// Buffer com espaço para o painel e MAX_CHARS caracteres, reescrito a cada draw
+	glGenVertexArrays(1, &vao);
+	glGenBuffers(1, &vbo);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, (MAX_CHARS + 1) * 6 * sizeof(Vertex), NULL, GL_STREAM_DRAW);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *)offsetof(Vertex, x));
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (GLvoid *)offsetof(Vertex, u));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (GLvoid *)offsetof(Vertex, color));
+	glEnableVertexAttribArray(2);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	// O painel ocupa os 6 primeiros vértices, preenchidos no draw
+	vertices.reserve((MAX_CHARS + 1) * 6);
+	vertices.resize(6);
+	ready = true;
+	return true;
+}
+
+void DebugHud::shutdown()
+{
+	if (!ready)
+	{
+		return;
+	}
+	glDeleteProgram(program);
+	glDeleteTextures(1, &fontTexture);
+	glDeleteBuffers(1, &vbo);
+	glDeleteVertexArrays(1, &vao);
+	ready = false;
+}
+
+void DebugHud::setQuad(Vertex *quad, float x0, float y0, float x1, float y1, float u0, float u1, uint32_t color)
+{
+	// Dois triângulos; v = 0 é a linha de cima da célula
+	quad[0] = {x0, y0, u0, 0.0f, color};
+	quad[1] = {x0, y1, u0, 1.0f, color};
+	quad[2] = {x1, y0, u1, 0.0f, color};
+	quad[3] = {x0, y1, u0, 1.0f, color};
+	quad[4] = {x1, y1, u1, 1.0f, color};
+	quad[5] = {x1, y0, u1, 0.0f, color};
+}
+
+void DebugHud::print(float x, float y, const char *text, uint32_t color)
+{
+	if (!ready)
+	{
+		return;
+	}
+	const float textureWidth = (float)((NUM_GLYPHS + 1) * CELL_WIDTH);
+	const float advance = CELL_WIDTH * scale, lineHeight = CELL_HEIGHT * scale;
+	bool empty = vertices.size() == 6;
+	float penX = x, penY = y;
+	for (const char *c = text; *c; c++)
+	{
+		if (*c == '\n')
+		{
+			penX = x;
+			penY += lineHeight;
+			continue;
+		}
+		if (vertices.size() >= (MAX_CHARS + 1) * 6)
+		{
+			break;
+		}
+		char ch = *c >= 'a' && *c <= 'z' ? *c - 'a' + 'A' : *c;
+		int glyph = ch >= FIRST_CHAR && ch <= LAST_CHAR ? ch - FIRST_CHAR : '?' - FIRST_CHAR;
+		if (glyph != 0)
+		{
+			float u0 = glyph * CELL_WIDTH / textureWidth;
+			size_t first = vertices.size();
+			vertices.resize(first + 6);
+			setQuad(&vertices[first], penX, penY, penX + advance, penY + lineHeight, u0, u0 + CELL_WIDTH / textureWidth, color);
+		}
+
+		if (empty)
+		{
+			minX = maxX = penX;
+			minY = maxY = penY;
+			empty = false;
+		}
+		minX = penX < minX ? penX : minX;
+		minY = penY < minY ? penY : minY;
+		maxX = penX + advance > maxX ? penX + advance : maxX;
+		maxY = penY + lineHeight > maxY ? penY + lineHeight : maxY;
+		penX += advance;
+	}
+}
+
+void DebugHud::draw(int viewportWidth, int viewportHeight)
+{
+	if (!ready || vertices.size() == 6)
+	{
+		return;
+	}
+
+	// Painel atrás de tudo, amostrando a célula sólida da fonte
+	const float textureWidth = (float)((NUM_GLYPHS + 1) * CELL_WIDTH);
+	float solidU = (SOLID_GLYPH * CELL_WIDTH + 0.5f * CELL_WIDTH) / textureWidth;
+	setQuad(vertices.data(), minX - PANEL_MARGIN, minY - PANEL_MARGIN, maxX + PANEL_MARGIN, maxY + PANEL_MARGIN, solidU, solidU, PANEL_COLOR);
+
+	GLint previousProgram, previousVao, previousBuffer, previousTexture;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &previousProgram);
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVao);
+	glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &previousTexture);
+
+	glUseProgram(program);
+	glUniform2f(viewportLocation, (float)viewportWidth, (float)viewportHeight);
+	glBindTexture(GL_TEXTURE_2D, fontTexture);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	// Órfão antes de escrever: o driver não espera o draw do frame anterior
+	glBufferData(GL_ARRAY_BUFFER, (MAX_CHARS + 1) * 6 * sizeof(Vertex), NULL, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+	glDrawArrays(GL_TRIANGLES, 0, (GLsizei)vertices.size());
+
+	glBindBuffer(GL_ARRAY_BUFFER, previousBuffer);
+	glBindVertexArray(previousVao);
+	glBindTexture(GL_TEXTURE_2D, previousTexture);
+	glUseProgram(previousProgram);
+
+	vertices.resize(6);
+}
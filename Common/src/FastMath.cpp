@@ -0,0 +1,25 @@
+#include "FastMath.h"
+
+void fastSinCos(const float *x, float *sines, float *cosines, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		fastSinCos(x[i], sines[i], cosines[i]);
+	}
+}
+
+void fastAtan2(const float *y, const float *x, float *angles, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		angles[i] = fastAtan2(y[i], x[i]);
+	}
+}
+
+void fastRsqrt(const float *x, float *out, uint32_t count)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		out[i] = fastRsqrt(x[i]);
+	}
+}
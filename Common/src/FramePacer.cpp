@@ -0,0 +1,168 @@
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+	// Folga somada à estimativa do trabalho no modo de baixa latência
+	const double LOW_LATENCY_MARGIN_MS = 1.0;
+	// Quanto a estimativa do trabalho desce por frame quando o frame foi mais rápido
+	const double WORK_DECAY = 0.05;
+}
+
+FramePacer::FramePacer(PacingMode mode, double targetFps)
+	: current(mode), periodMs(1000.0 / targetFps), workEstimate(periodMs * 0.5), frameSleep(0.0), frameSpin(0.0),
+	  sleepMean(1.0), sleepM2(0.0), sleepSamples(1), frames(0)
+{
+	workStart = lastSwap = nextDeadline = Clock::now();
+	std::fill(frameTimes, frameTimes + HISTORY, 0.0);
+	std::fill(workTimes, workTimes + HISTORY, 0.0);
+	std::fill(sleepTimes, sleepTimes + HISTORY, 0.0);
+	std::fill(spinTimes, spinTimes + HISTORY, 0.0);
+}
+
+const char *FramePacer::modeName(PacingMode mode)
+{
+	switch (mode)
+	{
+	case PACING_VSYNC:
+		return "vsync";
+	case PACING_UNCAPPED:
+		return "sem limite";
+	case PACING_CAPPED:
+		return "limitado com sleep";
+	case PACING_LOW_LATENCY:
+		return "baixa latencia";
+	default:
+		return "?";
+	}
+}
+
+void FramePacer::setMode(PacingMode mode, double targetFps)
+{
+	current = mode;
+	periodMs = 1000.0 / targetFps;
+	nextDeadline = Clock::now() + fromMs(periodMs);
+	workEstimate = periodMs * 0.5; // começa conservador e desce até o trabalho real
+	frames = 0; // as estatísticas do modo anterior não valem para o novo
+}
+
+FramePacer::Clock::duration FramePacer::fromMs(double ms) const
+{
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline)
+{
+	Clock::time_point start = Clock::now();
+
+	// Dorme em fatias de 1 ms enquanto sobra mais que o atraso esperado de uma fatia
+	for (;;)
+	{
+		double remaining = toMs(deadline - Clock::now());
+		double estimate = sleepMean + std::sqrt(sleepM2 / sleepSamples);
+		if (remaining <= estimate)
+		{
+			break;
+		}
+		Clock::time_point before = Clock::now();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		double observed = toMs(Clock::now() - before);
+
+		sleepSamples++;
+		double delta = observed - sleepMean;
+		sleepMean += delta / sleepSamples;
+		sleepM2 += delta * (observed - sleepMean);
+	}
+	Clock::time_point spinStart = Clock::now();
+
+	// O resto em spin
+	while (Clock::now() < deadline)
+	{
+	}
+
+	Clock::time_point end = Clock::now();
+	frameSleep += toMs(spinStart - start);
+	frameSpin += toMs(end - spinStart);
+}
+
+void FramePacer::beginFrame()
+{
+	if (current == PACING_LOW_LATENCY)
+	{
+		// Começa o mais tarde possível: vblank esperado menos o trabalho estimado
+		Clock::time_point start = lastSwap + fromMs(periodMs - workEstimate - LOW_LATENCY_MARGIN_MS);
+		if (start > Clock::now())
+		{
+			sleepUntil(start);
+		}
+	}
+	workStart = Clock::now();
+}
+
+void FramePacer::beforeSwap()
+{
+	double work = toMs(Clock::now() - workStart);
+	workEstimate = work > workEstimate ? work : workEstimate - (workEstimate - work) * WORK_DECAY;
+	workTimes[frames % HISTORY] = work;
+}
+
+void FramePacer::endFrame()
+{
+	Clock::time_point swap = Clock::now();
+	uint32_t slot = frames % HISTORY;
+	frameTimes[slot] = toMs(swap - lastSwap);
+	lastSwap = swap;
+
+	if (current == PACING_CAPPED)
+	{
+		if (swap - nextDeadline > fromMs(periodMs))
+		{
+			nextDeadline = swap; // atrasou mais de um frame: não tenta recuperar
+		}
+		sleepUntil(nextDeadline);
+		nextDeadline += fromMs(periodMs);
+	}
+
+	sleepTimes[slot] = frameSleep;
+	spinTimes[slot] = frameSpin;
+	frameSleep = frameSpin = 0.0;
+	frames++;
+}
+
+FrameStats FramePacer::stats() const
+{
+	FrameStats s = {};
+	uint32_t n = (uint32_t)std::min<uint64_t>(frames, HISTORY);
+	s.frames = n;
+	if (n == 0)
+	{
+		return s;
+	}
+
+	double sorted[HISTORY];
+	std::copy(frameTimes, frameTimes + n, sorted);
+	std::sort(sorted, sorted + n);
+	s.p50 = sorted[n / 2];
+	s.p99 = sorted[(uint32_t)std::ceil(0.99 * n) - 1];
+	s.minimum = sorted[0];
+	s.maximum = sorted[n - 1];
+
+	double sum = 0.0, sumSq = 0.0;
+	for (uint32_t i = 0; i < n; i++)
+	{
+		sum += frameTimes[i];
+		sumSq += frameTimes[i] * frameTimes[i];
+		s.workMean += workTimes[i];
+		s.sleepMean += sleepTimes[i];
+		s.spinMean += spinTimes[i];
+	}
+	s.mean = sum / n;
+	s.stddev = std::sqrt(std::max(0.0, sumSq / n - s.mean * s.mean));
+	s.workMean /= n;
+	s.sleepMean /= n;
+	s.spinMean /= n;
+	return s;
+}
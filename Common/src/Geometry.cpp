@@ -0,0 +1,138 @@
+#include "Geometry.h"
+
+#include <cmath>
+
+namespace
+{
+	const uint32_t CHUNK = 64;             // ângulos por pedaço da tabela em dois níveis
+	const uint32_t PARALLEL_GRAIN = 16384; // vértices por job
+	const uint32_t PARALLEL_MIN = 65536;   // abaixo disso o custo de agendar não compensa
+	const double TWO_PI = 6.283185307179586;
+
+	// Chama emit(i, cos(i * slice), sin(i * slice)) para i em [first, last)
+	template <class F>
+	void sweepAngles(double slice, uint32_t first, uint32_t last, F emit)
+	{
+		float offsetCos[CHUNK], offsetSin[CHUNK];
+		for (uint32_t k = 0; k < CHUNK; k++)
+		{
+			offsetCos[k] = (float)std::cos(k * slice);
+			offsetSin[k] = (float)std::sin(k * slice);
+		}
+
+		// Pedaços alinhados a múltiplos de CHUNK: o resultado não depende de como o intervalo foi dividido
+		for (uint32_t base = first - first % CHUNK; base < last; base += CHUNK)
+		{
+			double angle = base * slice;
+			float baseCos = (float)std::cos(angle), baseSin = (float)std::sin(angle);
+			uint32_t begin = base < first ? first - base : 0;
+			uint32_t end = last - base < CHUNK ? last - base : CHUNK;
+			for (uint32_t k = begin; k < end; k++)
+			{
+				emit(base + k, baseCos * offsetCos[k] - baseSin * offsetSin[k], baseSin * offsetCos[k] + baseCos * offsetSin[k]);
+			}
+		}
+	}
+
+	// body(first, last) sobre [0, count), dividido entre as threads quando vale a pena
+	template <class F>
+	void forRange(JobSystem *jobs, uint32_t count, F &body)
+	{
+		if (jobs == nullptr || count < PARALLEL_MIN)
+		{
+			body(0, count);
+			return;
+		}
+		JobCounter done;
+		jobs->parallelFor(count, PARALLEL_GRAIN, body, done);
+		jobs->wait(done);
+	}
+
+	// Leque com raio por vértice: radius(i) para o vértice i da borda
+	template <class R>
+	void generateFan(Mesh &mesh, const SinCosTable &table, R radius, JobSystem *jobs)
+	{
+		uint32_t n = table.size();
+		mesh.vertices.resize(3 * (n + 1));
+		mesh.indices.resize(3 * n);
+		float *vertices = mesh.vertices.data();
+		uint32_t *indices = mesh.indices.data();
+		const float *cosines = table.cosines();
+		const float *sines = table.sines();
+
+		vertices[0] = vertices[1] = vertices[2] = 0.0f;
+		auto body = [&](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < last; i++)
+			{
+				float r = radius(i);
+				float *v = vertices + 3 * (i + 1);
+				v[0] = r * cosines[i];
+				v[1] = r * sines[i];
+				v[2] = 0.0f;
+
+				// Triângulo (centro, i, próximo), fechando no primeiro vértice da borda
+				uint32_t *t = indices + 3 * i;
+				t[0] = 0;
+				t[1] = i + 1;
+				t[2] = i + 1 < n ? i + 2 : 1;
+			}
+		};
+		forRange(jobs, n, body);
+	}
+}
+
+SinCosTable::SinCosTable(uint32_t slices, JobSystem *jobs) : cosTable(slices), sinTable(slices)
+{
+	double slice = TWO_PI / slices;
+	float *cosines = cosTable.data();
+	float *sines = sinTable.data();
+	auto body = [&](uint32_t first, uint32_t last) {
+		sweepAngles(slice, first, last, [&](uint32_t i, float c, float s) {
+			cosines[i] = c;
+			sines[i] = s;
+		});
+	};
+	forRange(jobs, slices, body);
+}
+
+void generateCircle(Mesh &mesh, const SinCosTable &table, float radius, JobSystem *jobs)
+{
+	generateFan(mesh, table, [radius](uint32_t) { return radius; }, jobs);
+}
+
+void generateStar(Mesh &mesh, const SinCosTable &table, float minRadius, float maxRadius, JobSystem *jobs)
+{
+	generateFan(mesh, table, [minRadius, maxRadius](uint32_t i) { return (i & 1) ? minRadius : maxRadius; }, jobs);
+}
+
+uint32_t spiralPointCount(float maxAngle, float slice)
+{
+	// Contagem inteira em vez de acumular o ângulo num float
+	return (uint32_t)std::ceil((double)maxAngle / slice);
+}
+
+void generateSpiral(Mesh &mesh, float maxAngle, float slice, float startRadius, float growth, JobSystem *jobs)
+{
+	uint32_t n = spiralPointCount(maxAngle, slice);
+	mesh.vertices.resize(3 * (n + 1));
+	mesh.indices.resize(n > 1 ? 2 * (n - 1) : 0);
+	float *vertices = mesh.vertices.data();
+	uint32_t *indices = mesh.indices.data();
+
+	vertices[0] = vertices[1] = vertices[2] = 0.0f;
+	auto body = [&](uint32_t first, uint32_t last) {
+		sweepAngles(slice, first, last, [&](uint32_t i, float c, float s) {
+			float r = startRadius + i * growth;
+			float *v = vertices + 3 * (i + 1);
+			v[0] = r * c;
+			v[1] = r * s;
+			v[2] = 0.0f;
+			if (i + 1 < n)
+			{
+				indices[2 * i] = i + 1;
+				indices[2 * i + 1] = i + 2;
+			}
+		});
+	};
+	forRange(jobs, n, body);
+}
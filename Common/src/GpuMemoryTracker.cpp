@@ -0,0 +1,258 @@
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <glad/glad.h>
+#include <unordered_map>
+
+namespace
+{
+	std::unordered_map<GLuint, int64_t> bufferBytes;
+	std::unordered_map<GLuint, int64_t> renderbufferBytes;
+	const GLint MAX_LEVELS = 16; // até 32768 pixels de lado
+
+	struct TextureBytes
+	{
+		int64_t levels[MAX_LEVELS]; // por nível especificado (todas as camadas); respecificar substitui
+		int64_t mipmaps;			// estimativa da cadeia do glGenerateMipmap, a partir do nível 0
+
+		int64_t total() const
+		{
+			int64_t bytes = mipmaps;
+			for (GLint level = 0; level < MAX_LEVELS; level++)
+			{
+				bytes += levels[level];
+			}
+			return bytes;
+		}
+	};
+	std::unordered_map<GLuint, TextureBytes> textureBytes;
+
+	bool installed = false;
+
+	// Nome do objeto ligado ao alvo; 0 para alvos que não acompanhamos.
+	// glGetIntegerv é chamado a cada (re)alocação, nunca por draw; um buffer que faz orphaning com
+	// glBufferData a cada frame (o VBO do DebugHud, com o HUD aberto) paga essa consulta por frame
+	GLuint boundObject(GLenum bindingQuery)
+	{
+		GLint name = 0;
+		glGetIntegerv(bindingQuery, &name);
+		return (GLuint)name;
+	}
+
+	GLenum bufferBindingQuery(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_ARRAY_BUFFER:
+			return GL_ARRAY_BUFFER_BINDING;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+		case GL_UNIFORM_BUFFER:
+			return GL_UNIFORM_BUFFER_BINDING;
+		case GL_PIXEL_PACK_BUFFER:
+			return GL_PIXEL_PACK_BUFFER_BINDING;
+		case GL_PIXEL_UNPACK_BUFFER:
+			return GL_PIXEL_UNPACK_BUFFER_BINDING;
+		// A GLAD não define os *_BINDING destes dois: o enum do binding tem o mesmo valor do alvo
+		case GL_COPY_READ_BUFFER:
+		case GL_COPY_WRITE_BUFFER:
+			return target;
+		}
+		return 0;
+	}
+
+	GLenum textureBindingQuery(GLenum target)
+	{
+		switch (target)
+		{
+		case GL_TEXTURE_2D:
+			return GL_TEXTURE_BINDING_2D;
+		case GL_TEXTURE_2D_ARRAY:
+			return GL_TEXTURE_BINDING_2D_ARRAY;
+		case GL_TEXTURE_3D:
+			return GL_TEXTURE_BINDING_3D;
+		}
+		return 0;
+	}
+
+	// Bytes por pixel do formato interno; formatos sem tamanho ficam com 4 (o que os drivers costumam usar)
+	int64_t formatBytes(GLint internalformat)
+	{
+		switch (internalformat)
+		{
+		case GL_R8:
+		case GL_RED:
+			return 1;
+		case GL_RG8:
+		case GL_RG:
+		case GL_R16F:
+		case GL_DEPTH_COMPONENT16:
+			return 2;
+		case GL_RGBA16F:
+		case GL_RG32F:
+			return 8;
+		case GL_RGBA32F:
+			return 16;
+		}
+		return 4;
+	}
+
+	void textureLevel(GLenum target, GLint level, int64_t bytes)
+	{
+		GLenum query = textureBindingQuery(target);
+		GLuint texture = query && level >= 0 && level < MAX_LEVELS ? boundObject(query) : 0;
+		if (texture == 0)
+		{
+			return;
+		}
+		TextureBytes &entry = textureBytes[texture];
+		int64_t old = entry.total();
+		entry.levels[level] = bytes;
+		if (level == 0)
+		{
+			// Nível 0 respecificado: o tamanho muda e a cadeia de mipmaps antiga deixa de valer
+			entry.mipmaps = 0;
+		}
+		trackGpuResize(GpuMemoryKind::Textures, old, entry.total());
+	}
+
+	void releaseObjects(GpuMemoryKind kind, std::unordered_map<GLuint, int64_t> &sizes, GLsizei n, const GLuint *names)
+	{
+		for (GLsizei i = 0; i < n; i++)
+		{
+			auto found = sizes.find(names[i]);
+			if (found != sizes.end())
+			{
+				trackGpuResize(kind, found->second, 0);
+				sizes.erase(found);
+			}
+		}
+	}
+
+	decltype(glad_glBufferData) originalBufferData = nullptr;
+	void APIENTRY trackedBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+	{
+		GLenum query = bufferBindingQuery(target);
+		GLuint buffer = query ? boundObject(query) : 0;
+		if (buffer != 0)
+		{
+			int64_t &bytes = bufferBytes[buffer];
+			trackGpuResize(GpuMemoryKind::Buffers, bytes, size);
+			bytes = size;
+		}
+		originalBufferData(target, size, data, usage);
+	}
+
+	decltype(glad_glDeleteBuffers) originalDeleteBuffers = nullptr;
+	void APIENTRY trackedDeleteBuffers(GLsizei n, const GLuint *buffers)
+	{
+		releaseObjects(GpuMemoryKind::Buffers, bufferBytes, n, buffers);
+		originalDeleteBuffers(n, buffers);
+	}
+
+	decltype(glad_glTexImage2D) originalTexImage2D = nullptr;
+	void APIENTRY trackedTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels)
+	{
+		textureLevel(target, level, (int64_t)width * height * formatBytes(internalformat));
+		originalTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+	}
+
+	decltype(glad_glTexImage3D) originalTexImage3D = nullptr;
+	void APIENTRY trackedTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels)
+	{
+		textureLevel(target, level, (int64_t)width * height * depth * formatBytes(internalformat));
+		originalTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+	}
+
+	// A cadeia completa de mipmaps soma 1/3 do nível 0
+	decltype(glad_glGenerateMipmap) originalGenerateMipmap = nullptr;
+	void APIENTRY trackedGenerateMipmap(GLenum target)
+	{
+		GLenum query = textureBindingQuery(target);
+		GLuint texture = query ? boundObject(query) : 0;
+		auto found = textureBytes.find(texture);
+		if (found != textureBytes.end())
+		{
+			// A cadeia gerada substitui os níveis acima do 0 que tenham sido especificados à mão
+			TextureBytes &entry = found->second;
+			int64_t old = entry.total();
+			std::fill(entry.levels + 1, entry.levels + MAX_LEVELS, 0);
+			entry.mipmaps = entry.levels[0] / 3;
+			trackGpuResize(GpuMemoryKind::Textures, old, entry.total());
+		}
+		originalGenerateMipmap(target);
+	}
+
+	decltype(glad_glDeleteTextures) originalDeleteTextures = nullptr;
+	void APIENTRY trackedDeleteTextures(GLsizei n, const GLuint *textures)
+	{
+		for (GLsizei i = 0; i < n; i++)
+		{
+			auto found = textureBytes.find(textures[i]);
+			if (found != textureBytes.end())
+			{
+				trackGpuResize(GpuMemoryKind::Textures, found->second.total(), 0);
+				textureBytes.erase(found);
+			}
+		}
+		originalDeleteTextures(n, textures);
+	}
+
+	void renderbufferStorage(int64_t bytes)
+	{
+		GLuint renderbuffer = boundObject(GL_RENDERBUFFER_BINDING);
+		if (renderbuffer != 0)
+		{
+			int64_t &entry = renderbufferBytes[renderbuffer];
+			trackGpuResize(GpuMemoryKind::Renderbuffers, entry, bytes);
+			entry = bytes;
+		}
+	}
+
+	decltype(glad_glRenderbufferStorage) originalRenderbufferStorage = nullptr;
+	void APIENTRY trackedRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+	{
+		renderbufferStorage((int64_t)width * height * formatBytes(internalformat));
+		originalRenderbufferStorage(target, internalformat, width, height);
+	}
+
+	decltype(glad_glRenderbufferStorageMultisample) originalRenderbufferStorageMultisample = nullptr;
+	void APIENTRY trackedRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height)
+	{
+		renderbufferStorage((int64_t)width * height * formatBytes(internalformat) * (samples > 0 ? samples : 1));
+		originalRenderbufferStorageMultisample(target, samples, internalformat, width, height);
+	}
+
+	decltype(glad_glDeleteRenderbuffers) originalDeleteRenderbuffers = nullptr;
+	void APIENTRY trackedDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+	{
+		releaseObjects(GpuMemoryKind::Renderbuffers, renderbufferBytes, n, renderbuffers);
+		originalDeleteRenderbuffers(n, renderbuffers);
+	}
+}
+
+// Funções ausentes no contexto (ponteiro nulo) ficam como estão
+#define INSTALL(fn)                 \
+	if (glad_gl##fn != nullptr)     \
+	{                               \
+		original##fn = glad_gl##fn; \
+		glad_gl##fn = tracked##fn;  \
+	}
+
+void installGpuMemoryTracking()
+{
+	if (installed)
+	{
+		return;
+	}
+	INSTALL(BufferData)
+	INSTALL(DeleteBuffers)
+	INSTALL(TexImage2D)
+	INSTALL(TexImage3D)
+	INSTALL(GenerateMipmap)
+	INSTALL(DeleteTextures)
+	INSTALL(RenderbufferStorage)
+	INSTALL(RenderbufferStorageMultisample)
+	INSTALL(DeleteRenderbuffers)
+	installed = true;
+}
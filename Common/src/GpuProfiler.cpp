@@ -0,0 +1,132 @@
+#include "GpuProfiler.h"
+
+GpuProfiler gpuProfiler;
+
+namespace
+{
+	// Recalibra o relógio da GPU contra o da CPU de tempos em tempos (os dois derivam)
+	const uint64_t CALIBRATION_PERIOD = 256;
+}
+
+GpuProfiler::GpuProfiler() : current(0), ready(false), gpuToCpu(0), frameCount(0), dropped(0), frameMs(0.0)
+{
+}
+
+void GpuProfiler::init()
+{
+	for (FrameQueries &frame : frames)
+	{
+		glGenQueries(1, &frame.elapsed);
+		glGenQueries(2 * MAX_ZONES, frame.timestamps);
+		frame.zones = 0;
+		frame.pending = false;
+	}
+	calibrate();
+	ready = true;
+}
+
+void GpuProfiler::shutdown()
+{
+	if (!ready)
+	{
+		return;
+	}
+	for (FrameQueries &frame : frames)
+	{
+		glDeleteQueries(1, &frame.elapsed);
+		glDeleteQueries(2 * MAX_ZONES, frame.timestamps);
+	}
+	ready = false;
+}
+
+void GpuProfiler::calibrate()
+{
+	// GL_TIMESTAMP pelo glGet é o instante em que os comandos anteriores chegaram à GPU; não espera a execução
+	GLint64 gpuNow = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+	gpuToCpu = profiler.now() - gpuNow;
+}
+
+void GpuProfiler::collect(FrameQueries &frame)
+{
+	// O GL não garante ordem de disponibilidade entre GL_TIME_ELAPSED e GL_TIMESTAMP: cada query é
+	// conferida antes de qualquer leitura, e o frame inteiro é descartado se uma ainda não estiver pronta
+	GLuint available = 0;
+	glGetQueryObjectuiv(frame.elapsed, GL_QUERY_RESULT_AVAILABLE, &available);
+	for (uint32_t q = 0; available && q < 2 * frame.zones; q++)
+	{
+		glGetQueryObjectuiv(frame.timestamps[q], GL_QUERY_RESULT_AVAILABLE, &available);
+	}
+	if (!available)
+	{
+		dropped++;
+		return;
+	}
+
+	GLuint64 elapsed = 0;
+	glGetQueryObjectui64v(frame.elapsed, GL_QUERY_RESULT, &elapsed);
+	frameMs = elapsed / 1e6;
+
+	for (uint32_t z = 0; z < frame.zones; z++)
+	{
+		GLuint64 start = 0, end = 0;
+		glGetQueryObjectui64v(frame.timestamps[2 * z], GL_QUERY_RESULT, &start);
+		glGetQueryObjectui64v(frame.timestamps[2 * z + 1], GL_QUERY_RESULT, &end);
+		profiler.recordGpu(frame.names[z], (int64_t)start + gpuToCpu, (int64_t)end + gpuToCpu);
+	}
+}
+
+void GpuProfiler::beginFrame()
+{
+	if (!ready)
+	{
+		return;
+	}
+	current = (uint32_t)(frameCount % FRAMES);
+	FrameQueries &frame = frames[current];
+	if (frame.pending)
+	{
+		collect(frame);
+	}
+	if (frameCount % CALIBRATION_PERIOD == 0)
+	{
+		calibrate();
+	}
+
+	frame.zones = 0;
+	frame.pending = false;
+	glBeginQuery(GL_TIME_ELAPSED, frame.elapsed);
+}
+
+void GpuProfiler::endFrame()
+{
+	if (!ready)
+	{
+		return;
+	}
+	glEndQuery(GL_TIME_ELAPSED);
+	frames[current].pending = true;
+	frameCount++;
+}
+
+uint32_t GpuProfiler::beginZone(const char *name)
+{
+	FrameQueries &frame = frames[current];
+	if (!ready || frame.zones == MAX_ZONES)
+	{
+		return MAX_ZONES;
+	}
+	uint32_t zone = frame.zones++;
+	frame.names[zone] = name;
+	glQueryCounter(frame.timestamps[2 * zone], GL_TIMESTAMP);
+	return zone;
+}
+
+void GpuProfiler::endZone(uint32_t zone)
+{
+	if (zone == MAX_ZONES || !ready)
+	{
+		return;
+	}
+	glQueryCounter(frames[current].timestamps[2 * zone + 1], GL_TIMESTAMP);
+}
@@ -0,0 +1,244 @@
+#include "HeadlessContext.h"
+
+#include <glad/glad.h>
+
+#if defined(HEADLESS_EGL)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#elif defined(HEADLESS_OSMESA)
+#include <GL/osmesa.h>
+#else
+#include <GLFW/glfw3.h>
+#endif
+
+HeadlessContext::HeadlessContext()
+	: fboWidth(0), fboHeight(0), framebuffer(0), colorBuffer(0), depthBuffer(0), display(nullptr), context(nullptr), window(nullptr)
+{
+}
+
+HeadlessContext::~HeadlessContext()
+{
+	destroy();
+}
+
+const char *HeadlessContext::backendName()
+{
+#if defined(HEADLESS_EGL)
+	return "EGL surfaceless";
+#elif defined(HEADLESS_OSMESA)
+	return "OSMesa";
+#else
+	return "janela oculta da GLFW";
+#endif
+}
+
+#if defined(HEADLESS_EGL)
+
+bool HeadlessContext::createContext()
+{
+	// Plataforma surfaceless da Mesa quando existe; senão o display padrão (que pode exigir um servidor X)
+	EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	if (getPlatformDisplay != nullptr)
+	{
+		eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+	}
+	if (eglDisplay == EGL_NO_DISPLAY)
+	{
+		eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	EGLint major, minor;
+	if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, &major, &minor))
+	{
+		lastError = "EGL: nenhum display";
+		return false;
+	}
+	display = eglDisplay;
+	if (!eglBindAPI(EGL_OPENGL_API))
+	{
+		lastError = "EGL: sem OpenGL de desktop";
+		return false;
+	}
+
+	// Sem superfície: a config só precisa aceitar OpenGL
+	const EGLint configAttribs[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+	EGLConfig config;
+	EGLint configs = 0;
+	if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &configs) || configs == 0)
+	{
+		lastError = "EGL: nenhuma config com OpenGL";
+		return false;
+	}
+	const EGLint contextAttribs[] = {
+		EGL_CONTEXT_MAJOR_VERSION, 4,
+		EGL_CONTEXT_MINOR_VERSION, 0,
+		EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+		EGL_NONE };
+	EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttribs);
+	if (eglContext == EGL_NO_CONTEXT)
+	{
+		lastError = "EGL: contexto GL 4.0 core recusado";
+		return false;
+	}
+	context = eglContext;
+	if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext))
+	{
+		lastError = "EGL: sem EGL_KHR_surfaceless_context";
+		return false;
+	}
+	return gladLoadGLLoader((GLADloadproc)eglGetProcAddress) != 0;
+}
+
+void HeadlessContext::destroyContext()
+{
+	if (display != nullptr)
+	{
+		eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		if (context != nullptr)
+		{
+			eglDestroyContext(display, context);
+		}
+		eglTerminate(display);
+	}
+}
+
+#elif defined(HEADLESS_OSMESA)
+
+bool HeadlessContext::createContext()
+{
+	const int attribs[] = {
+		OSMESA_FORMAT, OSMESA_RGBA,
+		OSMESA_DEPTH_BITS, 24,
+		OSMESA_PROFILE, OSMESA_CORE_PROFILE,
+		OSMESA_CONTEXT_MAJOR_VERSION, 4,
+		OSMESA_CONTEXT_MINOR_VERSION, 0,
+		0 };
+	OSMesaContext osmesaContext = OSMesaCreateContextAttribs(attribs, NULL);
+	if (osmesaContext == NULL)
+	{
+		lastError = "OSMesa: contexto GL 4.0 core recusado";
+		return false;
+	}
+	context = osmesaContext;
+	osmesaBuffer.resize((size_t)fboWidth * fboHeight * 4);
+	if (!OSMesaMakeCurrent(osmesaContext, osmesaBuffer.data(), GL_UNSIGNED_BYTE, fboWidth, fboHeight))
+	{
+		lastError = "OSMesa: OSMesaMakeCurrent falhou";
+		return false;
+	}
+	return gladLoadGLLoader((GLADloadproc)OSMesaGetProcAddress) != 0;
+}
+
+void HeadlessContext::destroyContext()
+{
+	if (context != nullptr)
+	{
+		OSMesaDestroyContext((OSMesaContext)context);
+	}
+	osmesaBuffer.clear();
+}
+
+#else
+
+bool HeadlessContext::createContext()
+{
+	if (!glfwInit())
+	{
+		lastError = "GLFW: glfwInit falhou";
+		return false;
+	}
+	// O mesmo GL 4.0 core dos outros backends; sem isso alguns drivers dão um contexto legado
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow *hidden = glfwCreateWindow(fboWidth, fboHeight, "headless", nullptr, nullptr);
+	if (hidden == nullptr)
+	{
+		lastError = "GLFW: nao criou a janela oculta";
+		return false;
+	}
+	window = hidden;
+	glfwMakeContextCurrent(hidden);
+	return gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) != 0;
+}
+
+void HeadlessContext::destroyContext()
+{
+	if (window != nullptr)
+	{
+		glfwDestroyWindow((GLFWwindow *)window);
+		glfwTerminate();
+	}
+}
+
+#endif
+
+bool HeadlessContext::create(int width, int height)
+{
+	fboWidth = width;
+	fboHeight = height;
+	if (!createContext())
+	{
+		if (lastError.empty())
+		{
+			lastError = "GLAD: nao carregou as funcoes da OpenGL";
+		}
+		destroy();
+		return false;
+	}
+
+	glGenRenderbuffers(1, &colorBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glGenRenderbuffers(1, &depthBuffer);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+	glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+	glGenFramebuffers(1, &framebuffer);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		lastError = "FBO incompleto";
+		destroy();
+		return false;
+	}
+	bindFramebuffer();
+	return true;
+}
+
+void HeadlessContext::destroy()
+{
+	if (framebuffer != 0)
+	{
+		glDeleteFramebuffers(1, &framebuffer);
+		glDeleteRenderbuffers(1, &colorBuffer);
+		glDeleteRenderbuffers(1, &depthBuffer);
+		framebuffer = colorBuffer = depthBuffer = 0;
+	}
+	destroyContext();
+	display = context = window = nullptr;
+}
+
+void HeadlessContext::bindFramebuffer()
+{
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glViewport(0, 0, fboWidth, fboHeight);
+}
+
+void HeadlessContext::finish()
+{
+	glFinish();
+}
+
+void HeadlessContext::readPixels(std::vector<uint8_t> &rgba)
+{
+	rgba.resize((size_t)fboWidth * fboHeight * 4);
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, fboWidth, fboHeight, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+}
@@ -0,0 +1,66 @@
+#include "ImageCompare.h"
+
+#include <cmath>
+
+namespace
+{
+	// Maior delta possível (preto contra branco), para normalizar em 0..1
+	const double MAX_YIQ_DELTA = 35215.0;
+
+	double blend(uint8_t channel, uint8_t alpha)
+	{
+		return 255.0 + (channel - 255.0) * (alpha / 255.0);
+	}
+
+	double yiqDelta(const uint8_t *a, const uint8_t *b)
+	{
+		double r1 = blend(a[0], a[3]), g1 = blend(a[1], a[3]), b1 = blend(a[2], a[3]);
+		double r2 = blend(b[0], b[3]), g2 = blend(b[1], b[3]), b2 = blend(b[2], b[3]);
+		double dr = r1 - r2, dg = g1 - g2, db = b1 - b2;
+		double y = dr * 0.29889531 + dg * 0.58662247 + db * 0.11448223;
+		double i = dr * 0.59597799 - dg * 0.27417610 - db * 0.32180189;
+		double q = dr * 0.21147017 - dg * 0.52261711 + db * 0.31114694;
+		return 0.5053 * y * y + 0.299 * i * i + 0.1957 * q * q;
+	}
+}
+
+ImageDiff compareImages(const uint8_t *expected, const uint8_t *actual, int width, int height, float threshold, uint8_t *diff)
+{
+	ImageDiff result = {};
+	const double limit = MAX_YIQ_DELTA * threshold * threshold;
+	const uint32_t pixels = (uint32_t)width * height;
+	for (uint32_t p = 0; p < pixels; p++)
+	{
+		const uint8_t *a = expected + 4 * p;
+		const uint8_t *b = actual + 4 * p;
+		double delta = (a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3]) ? 0.0 : yiqDelta(a, b);
+		if (delta > result.maxDelta)
+		{
+			result.maxDelta = delta;
+		}
+		bool different = delta > limit;
+		if (different)
+		{
+			result.differentPixels++;
+		}
+		if (diff != nullptr)
+		{
+			uint8_t *d = diff + 4 * p;
+			if (different)
+			{
+				d[0] = 255;
+				d[1] = d[2] = 0;
+			}
+			else
+			{
+				// Luminância da referência, clareada, para dar contexto
+				uint8_t gray = (uint8_t)(255.0 - 0.1 * (255.0 - (0.299 * blend(a[0], a[3]) + 0.587 * blend(a[1], a[3]) + 0.114 * blend(a[2], a[3]))));
+				d[0] = d[1] = d[2] = gray;
+			}
+			d[3] = 255;
+		}
+	}
+	result.maxDelta = std::sqrt(result.maxDelta / MAX_YIQ_DELTA);
+	result.fraction = pixels ? (double)result.differentPixels / pixels : 0.0;
+	return result;
+}
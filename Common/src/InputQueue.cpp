@@ -0,0 +1,109 @@
+#include "InputQueue.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool InputQueue::push(int key, int action)
+{
+	InputEvent event = { inputClockNs(), key, action };
+	return events.push(event);
+}
+
+bool InputQueue::popBefore(int64_t until, InputEvent &event)
+{
+	if (!events.peek(event) || event.timestamp >= until)
+	{
+		return false;
+	}
+	return events.pop(event);
+}
+
+KeyboardState::KeyboardState() : activeCount(0), oldest(0)
+{
+	std::fill(isDown, isDown + MAX_KEYS, false);
+	std::fill(downSince, downSince + MAX_KEYS, 0);
+	std::fill(held, held + MAX_KEYS, 0.0f);
+	std::fill(listed, listed + MAX_KEYS, false);
+}
+
+uint32_t KeyboardState::advance(InputQueue &queue, int64_t tickStart, int64_t tickEnd)
+{
+	double tickLength = (double)(tickEnd - tickStart);
+	oldest = 0;
+
+	// Zera o tick anterior; continuam ativas só as teclas ainda pressionadas
+	int stillDown = 0;
+	for (int i = 0; i < activeCount; i++)
+	{
+		int key = active[i];
+		held[key] = 0.0f;
+		listed[key] = isDown[key];
+		if (isDown[key])
+		{
+			active[stillDown++] = key;
+		}
+	}
+	activeCount = stillDown;
+
+	// Tempo pressionado dentro do tick, em ns, acumulado em held e convertido em fração no fim
+	uint32_t applied = 0;
+	InputEvent event;
+	while (queue.popBefore(tickEnd, event))
+	{
+		if (event.key < 0 || event.key >= MAX_KEYS)
+		{
+			continue;
+		}
+		if (applied++ == 0)
+		{
+			oldest = event.timestamp;
+		}
+
+		// Um evento atrasado (de antes do tick) conta como se fosse no início do tick
+		int64_t t = std::max(event.timestamp, tickStart);
+		int key = event.key;
+		if (event.action == 1 && !isDown[key])
+		{
+			if (!listed[key])
+			{
+				listed[key] = true;
+				active[activeCount++] = key;
+			}
+			isDown[key] = true;
+			downSince[key] = t;
+		}
+		else if (event.action == 0 && isDown[key])
+		{
+			isDown[key] = false;
+			held[key] += (float)(t - std::max(downSince[key], tickStart));
+		}
+	}
+
+	for (int i = 0; i < activeCount; i++)
+	{
+		int key = active[i];
+		if (isDown[key])
+		{
+			held[key] += (float)(tickEnd - std::max(downSince[key], tickStart));
+		}
+		if (held[key] > 0.0f)
+		{
+			held[key] = std::min(1.0f, (float)(held[key] / tickLength));
+		}
+	}
+	return applied;
+}
+
+double LatencySampler::percentile(double p) const
+{
+	uint32_t n = (uint32_t)std::min<uint64_t>(count, HISTORY);
+	if (n == 0)
+	{
+		return 0.0;
+	}
+	double sorted[HISTORY];
+	std::copy(samples, samples + n, sorted);
+	std::sort(sorted, sorted + n);
+	uint32_t index = (uint32_t)std::ceil(p * n);
+	return sorted[index > 0 ? index - 1 : 0];
+}
@@ -0,0 +1,77 @@
+#include "InstanceBuilder.h"
+
+#include <algorithm>
+
+InstanceBuilder::InstanceBuilder(uint32_t layerCount, uint32_t blockSize)
+	: layers(layerCount), blockSize(std::max(1u, blockSize)), source(nullptr), target(nullptr), writer(nullptr), count(0),
+	  starts(layerCount + 1, 0)
+{
+}
+
+void InstanceBuilder::countBlocks(void *data, uint32_t firstBlock, uint32_t lastBlock)
+{
+	InstanceBuilder &self = *(InstanceBuilder *)data;
+	for (uint32_t b = firstBlock; b < lastBlock; b++)
+	{
+		uint32_t *counts = &self.blockOffsets[b * self.layers];
+		uint32_t first = b * self.blockSize, last = std::min(first + self.blockSize, self.count);
+		for (uint32_t i = first; i < last; i++)
+		{
+			counts[self.source[i].layer]++;
+		}
+	}
+}
+
+template <bool Rotates>
+void InstanceBuilder::writeBlocks(void *data, uint32_t firstBlock, uint32_t lastBlock)
+{
+	InstanceBuilder &self = *(InstanceBuilder *)data;
+	SpriteInstance<Rotates> *target = (SpriteInstance<Rotates> *)self.target;
+	for (uint32_t b = firstBlock; b < lastBlock; b++)
+	{
+		uint32_t *cursor = &self.blockOffsets[b * self.layers];
+		uint32_t first = b * self.blockSize, last = std::min(first + self.blockSize, self.count);
+		for (uint32_t i = first; i < last; i++)
+		{
+			const InstanceSprite &sprite = self.source[i];
+			writeInstance(sprite, target[cursor[sprite.layer]++]);
+		}
+	}
+}
+
+// Os dois formatos que build pode pedir
+template void InstanceBuilder::writeBlocks<false>(void *, uint32_t, uint32_t);
+template void InstanceBuilder::writeBlocks<true>(void *, uint32_t, uint32_t);
+
+void InstanceBuilder::buildLayers(JobSystem &jobs, const InstanceSprite *sprites, uint32_t n)
+{
+	source = sprites;
+	count = n;
+	uint32_t blocks = (n + blockSize - 1) / blockSize;
+	blockOffsets.assign((size_t)blocks * layers, 0);
+
+	// 1. Contagem por bloco e camada
+	JobCounter counted;
+	jobs.run(countBlocks, this, 0, blocks, 1, counted);
+	jobs.wait(counted);
+
+	// 2. Soma de prefixos: camada por camada, bloco por bloco, para manter a ordem original
+	uint32_t running = 0;
+	for (uint32_t layer = 0; layer < layers; layer++)
+	{
+		starts[layer] = running;
+		for (uint32_t b = 0; b < blocks; b++)
+		{
+			uint32_t &slot = blockOffsets[b * layers + layer];
+			uint32_t blockCount = slot;
+			slot = running;
+			running += blockCount;
+		}
+	}
+	starts[layers] = running;
+
+	// 3. Cada bloco escreve nas suas fatias
+	JobCounter written;
+	jobs.run(writer, this, 0, blocks, 1, written);
+	jobs.wait(written);
+}
@@ -0,0 +1,266 @@
+#include "JobSystem.h"
+
+namespace
+{
+	// Índice da thread atual no sistema que a criou (a thread 0 é a que construiu o sistema)
+	thread_local const JobSystem *tlsSystem = nullptr;
+	thread_local uint32_t tlsThread = 0;
+
+	// Tentativas de achar trabalho antes de um worker dormir
+	const int SPIN_ROUNDS = 64;
+}
+
+bool JobSystem::WorkQueue::push(Job *job)
+{
+	int64_t b = bottom.load(std::memory_order_relaxed);
+	int64_t t = top.load(std::memory_order_acquire);
+	if (b - t >= (int64_t)CAPACITY)
+	{
+		return false;
+	}
+	slots[b & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+	return true;
+}
+
+Job *JobSystem::WorkQueue::pop()
+{
+	int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t t = top.load(std::memory_order_relaxed);
+
+	if (t > b)
+	{
+		// Vazio
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job *job = slots[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (t == b)
+	{
+		// Último elemento: disputa com os ladrões pelo topo
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			job = nullptr;
+		}
+		bottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+Job *JobSystem::WorkQueue::steal()
+{
+	int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	int64_t b = bottom.load(std::memory_order_acquire);
+	if (t >= b)
+	{
+		return nullptr;
+	}
+
+	Job *job = slots[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+	{
+		return nullptr; // outra thread levou primeiro
+	}
+	return job;
+}
+
+JobSystem::JobSystem(uint32_t threadCount)
+	: queued(0), sleeping(0), quit(false)
+{
+	if (threadCount == 0)
+	{
+		threadCount = 1;
+	}
+	for (uint32_t i = 0; i < threadCount; i++)
+	{
+		queues.push_back(new WorkQueue());
+		rings.push_back(new JobRing());
+	}
+
+	tlsSystem = this;
+	tlsThread = 0;
+	for (uint32_t i = 1; i < threadCount; i++)
+	{
+		workers.emplace_back(&JobSystem::workerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		quit.store(true);
+	}
+	wake.notify_all();
+	for (std::thread &worker : workers)
+	{
+		worker.join();
+	}
+	for (uint32_t i = 0; i < queues.size(); i++)
+	{
+		delete queues[i];
+		delete rings[i];
+	}
+	if (tlsSystem == this)
+	{
+		tlsSystem = nullptr;
+	}
+}
+
+uint32_t JobSystem::currentThread() const
+{
+	return tlsSystem == this ? tlsThread : 0;
+}
+
+Job *JobSystem::allocate(JobFunction function, void *data, uint32_t first, uint32_t last, uint32_t grain, JobCounter &counter)
+{
+	JobRing &ring = *rings[currentThread()];
+	Job *job = &ring.jobs[ring.next++ & (WorkQueue::CAPACITY - 1)];
+	job->function = function;
+	job->data = data;
+	job->first = first;
+	job->last = last;
+	job->grain = grain > 0 ? grain : 1;
+	job->counter = &counter;
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+	return job;
+}
+
+void JobSystem::submit(Job *job)
+{
+	if (!queues[currentThread()]->push(job))
+	{
+		// Deque cheio: executa na hora em vez de perder o job
+		execute(job);
+		return;
+	}
+	queued.fetch_add(1);
+	if (sleeping.load() > 0)
+	{
+		std::lock_guard<std::mutex> guard(sleepLock);
+		wake.notify_one();
+	}
+}
+
+void JobSystem::run(JobFunction function, void *data, uint32_t first, uint32_t last, uint32_t grain, JobCounter &counter)
+{
+	submit(allocate(function, data, first, last, grain, counter));
+}
+
+void JobSystem::runAfter(JobCounter &dependency, JobFunction function, void *data, uint32_t first, uint32_t last, uint32_t grain, JobCounter &counter)
+{
+	Job *job = allocate(function, data, first, last, grain, counter);
+	std::unique_lock<std::mutex> guard(dependency.lock);
+	if (dependency.pending.load(std::memory_order_acquire) > 0)
+	{
+		dependency.continuations.push_back(job);
+		return;
+	}
+	guard.unlock();
+	submit(job);
+}
+
+Job *JobSystem::findJob(uint32_t self)
+{
+	Job *job = queues[self]->pop();
+	uint32_t n = (uint32_t)queues.size();
+	for (uint32_t k = 1; !job && k < n; k++)
+	{
+		job = queues[(self + k) % n]->steal();
+	}
+	if (job)
+	{
+		queued.fetch_sub(1);
+	}
+	return job;
+}
+
+void JobSystem::execute(Job *job)
+{
+	// Divide ao meio enquanto o intervalo for maior que o grain; a metade direita fica para roubo
+	while (job->last - job->first > job->grain)
+	{
+		uint32_t mid = job->first + (job->last - job->first) / 2;
+		Job *right = allocate(job->function, job->data, mid, job->last, job->grain, *job->counter);
+		job->last = mid;
+		submit(right);
+	}
+	job->function(job->data, job->first, job->last);
+	finish(*job->counter);
+}
+
+void JobSystem::finish(JobCounter &counter)
+{
+	// Caminho rápido: não é o último job do contador
+	uint32_t pending = counter.pending.load(std::memory_order_acquire);
+	while (pending > 1)
+	{
+		if (counter.pending.compare_exchange_weak(pending, pending - 1, std::memory_order_acq_rel, std::memory_order_acquire))
+		{
+			return;
+		}
+	}
+
+	// Último job: libera as continuações e zera sob o lock, para que runAfter não perca nenhuma
+	std::lock_guard<std::mutex> guard(counter.lock);
+	for (Job *job : counter.continuations)
+	{
+		submit(job);
+	}
+	counter.continuations.clear();
+	counter.pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+	uint32_t self = currentThread();
+	while (!counter.done())
+	{
+		Job *job = findJob(self);
+		if (job)
+		{
+			execute(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+	// O último job ainda pode estar saindo do lock do contador; depois disso ele pode ser destruído
+	std::lock_guard<std::mutex> guard(counter.lock);
+}
+
+void JobSystem::workerLoop(uint32_t self)
+{
+	tlsSystem = this;
+	tlsThread = self;
+
+	while (!quit.load(std::memory_order_relaxed))
+	{
+		Job *job = nullptr;
+		for (int round = 0; !job && round < SPIN_ROUNDS; round++)
+		{
+			job = findJob(self);
+			if (!job)
+			{
+				std::this_thread::yield();
+			}
+		}
+		if (job)
+		{
+			execute(job);
+			continue;
+		}
+
+		// Sem trabalho: dorme até alguém empilhar um job
+		std::unique_lock<std::mutex> guard(sleepLock);
+		sleeping.fetch_add(1);
+		wake.wait(guard, [this]() { return quit.load() || queued.load() > 0; });
+		sleeping.fetch_sub(1);
+	}
+}
@@ -0,0 +1,216 @@
+#include "Logger.h"
+
+#include <chrono>
+#include <cinttypes>
+
+namespace
+{
+	const char *LEVEL_NAMES[] = { "DEBUG", "INFO", "AVISO", "ERRO" };
+	const int64_t RATE_WINDOW_NS = 1000000000;
+
+	int64_t steadyNanoseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+Logger::Logger(FILE *out, uint32_t capacity)
+	: out(out), epoch(steadyNanoseconds()), slots(capacity), mask(capacity - 1), tail(0), head(0), written(0), dropped(0),
+	  minLevel(LOG_INFO), categoryCount(0), quit(false)
+{
+	for (uint32_t i = 0; i < capacity; i++)
+	{
+		slots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	addCategory("geral");
+	writer = std::thread(&Logger::writerLoop, this);
+}
+
+Logger::~Logger()
+{
+	quit.store(true, std::memory_order_release);
+	writer.join();
+}
+
+uint16_t Logger::addCategory(const char *name, uint32_t maxPerSecond)
+{
+	uint16_t index = categoryCount.load(std::memory_order_relaxed);
+	if (index == MAX_CATEGORIES)
+	{
+		return 0;
+	}
+	Category &category = categories[index];
+	category.name = name;
+	category.maxPerSecond = maxPerSecond;
+	category.windowStart.store(0, std::memory_order_relaxed);
+	category.used.store(0, std::memory_order_relaxed);
+	category.suppressed.store(0, std::memory_order_relaxed);
+	categoryCount.store(index + 1, std::memory_order_release); // publica a categoria pronta
+	return index;
+}
+
+int64_t Logger::now() const
+{
+	return steadyNanoseconds() - epoch;
+}
+
+void Logger::submit(Record &record)
+{
+	record.timestamp = now();
+
+	// Limite por categoria em janelas de 1 s; aproximado sob disputa, mas sem lock
+	Category &category = categories[record.category < categoryCount.load(std::memory_order_acquire) ? record.category : 0];
+	if (category.maxPerSecond > 0)
+	{
+		int64_t start = category.windowStart.load(std::memory_order_relaxed);
+		if (record.timestamp - start >= RATE_WINDOW_NS &&
+			category.windowStart.compare_exchange_strong(start, record.timestamp, std::memory_order_relaxed))
+		{
+			category.used.store(0, std::memory_order_relaxed);
+		}
+		if (category.used.fetch_add(1, std::memory_order_relaxed) >= category.maxPerSecond)
+		{
+			category.suppressed.fetch_add(1, std::memory_order_relaxed);
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+	}
+
+	// Reserva um slot: o número de sequência diz se ele está livre para esta volta do anel
+	uint64_t pos = tail.load(std::memory_order_relaxed);
+	Slot *slot;
+	for (;;)
+	{
+		slot = &slots[pos & mask];
+		int64_t diff = (int64_t)slot->sequence.load(std::memory_order_acquire) - (int64_t)pos;
+		if (diff == 0)
+		{
+			if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if (diff < 0)
+		{
+			dropped.fetch_add(1, std::memory_order_relaxed); // anel cheio
+			return;
+		}
+		else
+		{
+			pos = tail.load(std::memory_order_relaxed);
+		}
+	}
+	slot->record = record;
+	slot->sequence.store(pos + 1, std::memory_order_release);
+}
+
+bool Logger::pop(Record &record)
+{
+	uint64_t pos = head.load(std::memory_order_relaxed);
+	Slot &slot = slots[pos & mask];
+	if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+	{
+		return false;
+	}
+	record = slot.record;
+	slot.sequence.store(pos + mask + 1, std::memory_order_release);
+	head.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+void Logger::write(const Record &record)
+{
+	const Category &category = categories[record.category < categoryCount.load(std::memory_order_acquire) ? record.category : 0];
+	fprintf(out, "[%10.3f] %-5s %s: ", record.timestamp * 1e-9, LEVEL_NAMES[record.level], category.name);
+
+	// Formatação adiada: cada {} do formato recebe o próximo argumento
+	uint32_t next = 0;
+	for (const char *c = record.format; *c; c++)
+	{
+		if (c[0] == '{' && c[1] == '}' && next < record.argCount)
+		{
+			const Arg &arg = record.args[next];
+			switch (record.types[next++])
+			{
+			case ARG_INT:
+				fprintf(out, "%" PRId64, arg.i);
+				break;
+			case ARG_UINT:
+				fprintf(out, "%" PRIu64, arg.u);
+				break;
+			case ARG_DOUBLE:
+				fprintf(out, "%g", arg.d);
+				break;
+			case ARG_BOOL:
+				fputs(arg.u ? "true" : "false", out);
+				break;
+			case ARG_STRING:
+				fputs(arg.s ? arg.s : "(null)", out);
+				break;
+			}
+			c++;
+		}
+		else
+		{
+			fputc(*c, out);
+		}
+	}
+	fputc('\n', out);
+}
+
+void Logger::writerLoop()
+{
+	for (;;)
+	{
+		bool stopping = quit.load(std::memory_order_acquire);
+
+		Record record;
+		bool wrote = false;
+		while (pop(record))
+		{
+			write(record);
+			wrote = true;
+		}
+
+		// Avisa quantos registros cada categoria perdeu para o limite
+		uint16_t count = categoryCount.load(std::memory_order_acquire);
+		for (uint16_t c = 0; c < count; c++)
+		{
+			uint32_t suppressed = categories[c].suppressed.exchange(0, std::memory_order_relaxed);
+			if (suppressed > 0)
+			{
+				fprintf(out, "[%10.3f] %-5s %s: %u mensagens suprimidas pelo limite de %u/s\n", now() * 1e-9,
+						LEVEL_NAMES[LOG_WARNING], categories[c].name, suppressed, categories[c].maxPerSecond);
+				wrote = true;
+			}
+		}
+
+		if (wrote)
+		{
+			fflush(out); // um flush por lote, fora do caminho quente
+			written.store(head.load(std::memory_order_relaxed), std::memory_order_release);
+		}
+		else if (stopping)
+		{
+			return;
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+void Logger::flush()
+{
+	uint64_t target = tail.load(std::memory_order_acquire);
+	while (written.load(std::memory_order_acquire) < target)
+	{
+		std::this_thread::yield();
+	}
+}
+
+uint64_t Logger::droppedCount() const
+{
+	return dropped.load(std::memory_order_relaxed);
+}
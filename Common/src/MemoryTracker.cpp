@@ -0,0 +1,199 @@
+#include "MemoryTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+	struct TagCounters
+	{
+		std::atomic<int64_t> bytes{0};
+		std::atomic<int64_t> peakBytes{0};
+		std::atomic<int64_t> liveAllocations{0};
+		std::atomic<uint64_t> totalAllocations{0};
+		std::atomic<int64_t> budget{0};
+	};
+
+	TagCounters tags[(int)MemoryTag::Count];
+
+	// Fica na frente do bloco; o tamanho mantém o alinhamento de malloc para o que vem depois
+	struct alignas(std::max_align_t) BlockHeader
+	{
+		size_t size;
+		MemoryTag tag;
+	};
+
+	void add(MemoryTag tag, int64_t size)
+	{
+		TagCounters &counters = tags[(int)tag];
+		int64_t bytes = counters.bytes.fetch_add(size, std::memory_order_relaxed) + size;
+		counters.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+		int64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+		while (bytes > peak && !counters.peakBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	void remove(MemoryTag tag, int64_t size)
+	{
+		TagCounters &counters = tags[(int)tag];
+		counters.bytes.fetch_sub(size, std::memory_order_relaxed);
+		counters.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	// GPU: só a thread de OpenGL mexe, sem atômicos
+	MemoryStats gpu[(int)GpuMemoryKind::Count] = {};
+}
+
+void *memoryAlloc(MemoryTag tag, size_t size)
+{
+	BlockHeader *header = (BlockHeader *)malloc(sizeof(BlockHeader) + size);
+	if (header == nullptr)
+	{
+		return nullptr;
+	}
+	header->size = size;
+	header->tag = tag;
+	add(tag, size);
+	return header + 1;
+}
+
+void *memoryRealloc(MemoryTag tag, void *pointer, size_t size)
+{
+	if (pointer == nullptr)
+	{
+		return memoryAlloc(tag, size);
+	}
+	BlockHeader *header = (BlockHeader *)pointer - 1;
+	size_t oldSize = header->size;
+	MemoryTag oldTag = header->tag;
+	BlockHeader *resized = (BlockHeader *)realloc(header, sizeof(BlockHeader) + size);
+	if (resized == nullptr)
+	{
+		return nullptr;
+	}
+	remove(oldTag, oldSize);
+	resized->size = size;
+	resized->tag = tag;
+	add(tag, size);
+	// Um realloc não é uma alocação nova
+	tags[(int)tag].totalAllocations.fetch_sub(1, std::memory_order_relaxed);
+	return resized + 1;
+}
+
+void memoryFree(void *pointer)
+{
+	if (pointer == nullptr)
+	{
+		return;
+	}
+	BlockHeader *header = (BlockHeader *)pointer - 1;
+	remove(header->tag, header->size);
+	free(header);
+}
+
+void trackAllocation(MemoryTag tag, size_t size)
+{
+	add(tag, size);
+}
+
+void trackFree(MemoryTag tag, size_t size)
+{
+	remove(tag, size);
+}
+
+void trackGpuResize(GpuMemoryKind kind, int64_t oldBytes, int64_t newBytes)
+{
+	MemoryStats &stats = gpu[(int)kind];
+	stats.bytes += newBytes - oldBytes;
+	if (oldBytes == 0 && newBytes != 0)
+	{
+		stats.liveAllocations++;
+		stats.totalAllocations++;
+	}
+	else if (oldBytes != 0 && newBytes == 0)
+	{
+		stats.liveAllocations--;
+	}
+	if (stats.bytes > stats.peakBytes)
+	{
+		stats.peakBytes = stats.bytes;
+	}
+}
+
+MemoryStats memoryStats(MemoryTag tag)
+{
+	const TagCounters &counters = tags[(int)tag];
+	MemoryStats stats;
+	stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+	stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	stats.liveAllocations = counters.liveAllocations.load(std::memory_order_relaxed);
+	stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+	stats.budget = counters.budget.load(std::memory_order_relaxed);
+	return stats;
+}
+
+MemoryStats gpuMemoryStats(GpuMemoryKind kind)
+{
+	return gpu[(int)kind];
+}
+
+void setMemoryBudget(MemoryTag tag, int64_t bytes)
+{
+	tags[(int)tag].budget.store(bytes, std::memory_order_relaxed);
+}
+
+void setGpuMemoryBudget(GpuMemoryKind kind, int64_t bytes)
+{
+	gpu[(int)kind].budget = bytes;
+}
+
+const char *memoryTagName(MemoryTag tag)
+{
+	static const char *const names[] = { "geral", "sprites", "espacial", "imagens", "shaders", "tiles" };
+	return names[(int)tag];
+}
+
+const char *gpuMemoryKindName(GpuMemoryKind kind)
+{
+	static const char *const names[] = { "gpu buffers", "gpu texturas", "gpu renderbuffers" };
+	return names[(int)kind];
+}
+
+namespace
+{
+	int formatLine(char *text, size_t size, const char *name, const MemoryStats &stats)
+	{
+		bool over = stats.budget > 0 && stats.bytes > stats.budget;
+		// Curta o bastante para caber no HUD: nome, bytes vivos, pico, alocações vivas/total
+		return snprintf(text, size, "%-17s %8.1f KB  pico %8.1f KB  %lld/%llu%s\n", name, stats.bytes / 1024.0, stats.peakBytes / 1024.0,
+						(long long)stats.liveAllocations, (unsigned long long)stats.totalAllocations, over ? "  ACIMA" : "");
+	}
+}
+
+int formatMemoryStats(char *text, size_t size)
+{
+	int length = 0;
+	auto append = [&](const char *name, const MemoryStats &stats) {
+		size_t offset = (size_t)length < size ? length : size;
+		length += formatLine(text + offset, size - offset, name, stats);
+	};
+	for (int tag = 0; tag < (int)MemoryTag::Count; tag++)
+	{
+		append(memoryTagName((MemoryTag)tag), memoryStats((MemoryTag)tag));
+	}
+	for (int kind = 0; kind < (int)GpuMemoryKind::Count; kind++)
+	{
+		append(gpuMemoryKindName((GpuMemoryKind)kind), gpu[kind]);
+	}
+	return length;
+}
+
+void dumpMemoryStats(FILE *file)
+{
+	char text[2048];
+	formatMemoryStats(text, sizeof(text));
+	fputs(text, file);
+	fflush(file);
+}
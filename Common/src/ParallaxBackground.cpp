@@ -0,0 +1,176 @@
+#include "ParallaxBackground.h"
+
+#include <algorithm>
+#include <cmath>
+#include "ShaderUtil.h"
+
+namespace
+{
+	// O u sai daqui, linear em x dentro de cada quad; o fragment shader só amostra
+	const GLchar *VERTEX_SHADER = R"(
+		#version 400
+		layout (location = 0) in vec4 vertex;	// canto em x (0 ou 1), y do mundo, v na folha e camada
+		uniform mat4 projection;
+		uniform vec2 area;						// minX, maxX
+		uniform vec4 layerPeriod;				// um componente por camada
+		uniform vec4 layerOffset;
+		out vec2 textureCoord;
+		void main() {
+			int layer = int(vertex.w);
+			float x = mix(area.x, area.y, vertex.x);
+			gl_Position = projection * vec4( x , vertex.y , 0.0 , 1.0 );
+			textureCoord = vec2((x + layerOffset[layer]) / layerPeriod[layer], vertex.z);
+		}
+	)";
+
+	const GLchar *FRAGMENT_SHADER = R"(
+		#version 400
+		in vec2 textureCoord;
+		uniform sampler2D layerSheet;
+		out vec4 color;
+		void main() { color = texture(layerSheet,textureCoord); }
+	)";
+
+	const uint32_t VERTICES_PER_LAYER = 6; // dois triângulos, sem buffer de índices
+}
+
+ParallaxBackground::ParallaxBackground()
+	: sheet(0), sheetWidth(1), sheetHeight(1), rows{}, bands{}, periods{}, rates{}, drifts{}, layers(0), dirty(false), program(0), vao(0),
+	  vbo(0), projectionLocation(-1), areaLocation(-1), periodLocation(-1), offsetLocation(-1)
+{
+}
+
+bool ParallaxBackground::init()
+{
+	program = buildProgram(VERTEX_SHADER, FRAGMENT_SHADER);
+	if (program == 0)
+	{
+		return false;
+	}
+	projectionLocation = glGetUniformLocation(program, "projection");
+	areaLocation = glGetUniformLocation(program, "area");
+	periodLocation = glGetUniformLocation(program, "layerPeriod");
+	offsetLocation = glGetUniformLocation(program, "layerOffset");
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "layerSheet"), 0);
+
+	glGenVertexArrays(1, &vao);
+	glGenBuffers(1, &vbo);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid *)0);
+	glEnableVertexAttribArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	dirty = true;
+	return true;
+}
+
+void ParallaxBackground::shutdown()
+{
+	if (program == 0)
+	{
+		return;
+	}
+	glDeleteVertexArrays(1, &vao);
+	glDeleteBuffers(1, &vbo);
+	glDeleteProgram(program);
+	program = vao = vbo = 0;
+}
+
+void ParallaxBackground::setProjection(const float *matrix)
+{
+	glUseProgram(program);
+	glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, matrix);
+}
+
+void ParallaxBackground::setSheet(GLuint texture)
+{
+	sheet = texture;
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &sheetWidth);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &sheetHeight);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	sheetWidth = sheetWidth > 0 ? sheetWidth : 1;
+	sheetHeight = sheetHeight > 0 ? sheetHeight : 1;
+}
+
+bool ParallaxBackground::addLayer(float vTop, float vBottom, float bottom, float top, float rate, float drift)
+{
+	if (layers >= MAX_PARALLAX_LAYERS || top <= bottom || vBottom <= vTop)
+	{
+		return false;
+	}
+
+	// Meio texel de margem, para a filtragem não puxar a linha da camada vizinha na folha
+	const float texelV = 0.5f / sheetHeight;
+	rows[layers][0] = vTop + texelV;
+	rows[layers][1] = vBottom - texelV;
+	bands[layers][0] = bottom;
+	bands[layers][1] = top;
+	// A faixa mostra as linhas sem distorcer: o período é a largura da folha na mesma escala
+	periods[layers] = (top - bottom) * sheetWidth / ((vBottom - vTop) * sheetHeight);
+	rates[layers] = rate;
+	drifts[layers] = drift;
+	layers++;
+	dirty = true;
+	return true;
+}
+
+void ParallaxBackground::clearLayers()
+{
+	layers = 0;
+	dirty = true;
+}
+
+void ParallaxBackground::draw(float minX, float maxX, float scroll, float seconds)
+{
+	if (layers == 0)
+	{
+		return;
+	}
+
+	glUseProgram(program);
+	glBindVertexArray(vao);
+	if (dirty)
+	{
+		// Dois triângulos por camada, com os cantos 0 e 1 embaixo e 2 e 3 em cima
+		const int order[VERTICES_PER_LAYER] = { 0, 1, 2, 2, 1, 3 };
+		GLfloat vertices[MAX_PARALLAX_LAYERS * VERTICES_PER_LAYER][4];
+		for (uint32_t i = 0; i < layers; i++)
+		{
+			const GLfloat corners[4][4] = {
+				{ 0.0f, bands[i][0], rows[i][1], (GLfloat)i },
+				{ 1.0f, bands[i][0], rows[i][1], (GLfloat)i },
+				{ 0.0f, bands[i][1], rows[i][0], (GLfloat)i },
+				{ 1.0f, bands[i][1], rows[i][0], (GLfloat)i } };
+			for (uint32_t k = 0; k < VERTICES_PER_LAYER; k++)
+			{
+				std::copy(corners[order[k]], corners[order[k]] + 4, vertices[i * VERTICES_PER_LAYER + k]);
+			}
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, layers * VERTICES_PER_LAYER * sizeof(vertices[0]), vertices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		dirty = false;
+	}
+
+	// Offset reduzido ao período aqui, em double: no shader, um u grande perderia os bits da fração
+	GLfloat period[MAX_PARALLAX_LAYERS] = { 1.0f, 1.0f, 1.0f, 1.0f }, offset[MAX_PARALLAX_LAYERS] = {};
+	for (uint32_t i = 0; i < layers; i++)
+	{
+		period[i] = periods[i];
+		offset[i] = (GLfloat)std::fmod((double)rates[i] * scroll + (double)drifts[i] * seconds, (double)periods[i]);
+	}
+	glUniform2f(areaLocation, minX, maxX);
+	glUniform4fv(periodLocation, 1, period);
+	glUniform4fv(offsetLocation, 1, offset);
+	glBindTexture(GL_TEXTURE_2D, sheet);
+	glDrawArrays(GL_TRIANGLES, 0, layers * VERTICES_PER_LAYER);
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
@@ -0,0 +1,314 @@
+#include "PngWriter.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+	const uint32_t WINDOW = 32768;	// distância máxima do deflate
+	const uint32_t MIN_MATCH = 3, MAX_MATCH = 258;
+	const uint32_t HASH_BITS = 15;
+	const uint32_t MAX_CHAIN = 32;	// candidatos testados por posição
+
+	uint32_t crcTable[256];
+	bool crcReady = false;
+
+	uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0)
+	{
+		if (!crcReady)
+		{
+			for (uint32_t n = 0; n < 256; n++)
+			{
+				uint32_t c = n;
+				for (int k = 0; k < 8; k++)
+				{
+					c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+				}
+				crcTable[n] = c;
+			}
+			crcReady = true;
+		}
+		crc = ~crc;
+		for (size_t i = 0; i < size; i++)
+		{
+			crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		}
+		return ~crc;
+	}
+
+	uint32_t adler32(const uint8_t *data, size_t size)
+	{
+		uint32_t a = 1, b = 0;
+		for (size_t i = 0; i < size; i++)
+		{
+			a = (a + data[i]) % 65521;
+			b = (b + a) % 65521;
+		}
+		return (b << 16) | a;
+	}
+
+	// Bits do deflate: do menos para o mais significativo dentro de cada byte
+	struct BitWriter
+	{
+		std::vector<uint8_t> &out;
+		uint32_t buffer = 0;
+		int count = 0;
+
+		explicit BitWriter(std::vector<uint8_t> &target) : out(target) {}
+
+		void bits(uint32_t value, int n)
+		{
+			buffer |= value << count;
+			count += n;
+			while (count >= 8)
+			{
+				out.push_back((uint8_t)buffer);
+				buffer >>= 8;
+				count -= 8;
+			}
+		}
+
+		// Códigos de Huffman vão do bit mais significativo para o menos
+		void code(uint32_t value, int n)
+		{
+			uint32_t reversed = 0;
+			for (int i = 0; i < n; i++)
+			{
+				reversed = (reversed << 1) | ((value >> i) & 1);
+			}
+			bits(reversed, n);
+		}
+
+		void flush()
+		{
+			if (count > 0)
+			{
+				out.push_back((uint8_t)buffer);
+			}
+			buffer = 0;
+			count = 0;
+		}
+	};
+
+	// Tabela de Huffman fixa (RFC 1951, 3.2.6)
+	void writeLiteral(BitWriter &w, uint32_t symbol)
+	{
+		if (symbol < 144)
+		{
+			w.code(0x30 + symbol, 8);
+		}
+		else if (symbol < 256)
+		{
+			w.code(0x190 + symbol - 144, 9);
+		}
+		else if (symbol < 280)
+		{
+			w.code(symbol - 256, 7);
+		}
+		else
+		{
+			w.code(0xC0 + symbol - 280, 8);
+		}
+	}
+
+	const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	const uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	const uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	void writeMatch(BitWriter &w, uint32_t length, uint32_t distance)
+	{
+		int l = 28;
+		while (LENGTH_BASE[l] > length)
+		{
+			l--;
+		}
+		writeLiteral(w, 257 + l);
+		w.bits(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+
+		int d = 29;
+		while (DISTANCE_BASE[d] > distance)
+		{
+			d--;
+		}
+		w.code(d, 5);
+		w.bits(distance - DISTANCE_BASE[d], DISTANCE_EXTRA[d]);
+	}
+
+	// Fluxo zlib com um único bloco deflate de Huffman fixo
+	std::vector<uint8_t> zlibCompress(const std::vector<uint8_t> &data)
+	{
+		std::vector<uint8_t> out;
+		out.push_back(0x78);
+		out.push_back(0x01);
+		BitWriter w(out);
+		w.bits(1, 1); // último bloco
+		w.bits(1, 2); // Huffman fixo
+
+		const uint32_t size = (uint32_t)data.size();
+		std::vector<int32_t> head(1u << HASH_BITS, -1), previous(size, -1);
+		auto hashAt = [&](uint32_t i) {
+			return ((data[i] << 10) ^ (data[i + 1] << 5) ^ data[i + 2]) & ((1u << HASH_BITS) - 1);
+		};
+		auto insert = [&](uint32_t i) {
+			if (i + MIN_MATCH <= size)
+			{
+				uint32_t h = hashAt(i);
+				previous[i] = head[h];
+				head[h] = (int32_t)i;
+			}
+		};
+
+		uint32_t i = 0;
+		while (i < size)
+		{
+			uint32_t bestLength = 0, bestDistance = 0;
+			if (i + MIN_MATCH <= size)
+			{
+				uint32_t limit = size - i < MAX_MATCH ? size - i : MAX_MATCH;
+				int32_t candidate = head[hashAt(i)];
+				for (uint32_t chain = 0; candidate >= 0 && i - candidate <= WINDOW && chain < MAX_CHAIN; chain++)
+				{
+					uint32_t length = 0;
+					while (length < limit && data[candidate + length] == data[i + length])
+					{
+						length++;
+					}
+					if (length > bestLength)
+					{
+						bestLength = length;
+						bestDistance = i - candidate;
+						if (length == limit)
+						{
+							break;
+						}
+					}
+					candidate = previous[candidate];
+				}
+			}
+
+			if (bestLength >= MIN_MATCH)
+			{
+				writeMatch(w, bestLength, bestDistance);
+				for (uint32_t k = 0; k < bestLength; k++)
+				{
+					insert(i + k);
+				}
+				i += bestLength;
+			}
+			else
+			{
+				writeLiteral(w, data[i]);
+				insert(i);
+				i++;
+			}
+		}
+		writeLiteral(w, 256); // fim do bloco
+		w.flush();
+
+		uint32_t adler = adler32(data.data(), data.size());
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			out.push_back((uint8_t)(adler >> shift));
+		}
+		return out;
+	}
+
+	uint8_t paeth(int a, int b, int c)
+	{
+		int p = a + b - c;
+		int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+		return (uint8_t)(pa <= pb && pa <= pc ? a : pb <= pc ? b : c);
+	}
+
+	// Linhas com o byte do filtro na frente, cada uma com o filtro de menor soma dos resíduos (com sinal)
+	std::vector<uint8_t> filterRows(const uint8_t *rgba, int width, int height)
+	{
+		const size_t stride = (size_t)width * 4;
+		std::vector<uint8_t> out;
+		out.reserve((stride + 1) * height);
+		std::vector<uint8_t> candidate(stride), best(stride);
+		for (int y = 0; y < height; y++)
+		{
+			const uint8_t *row = rgba + y * stride;
+			const uint8_t *up = y > 0 ? row - stride : nullptr;
+			uint64_t bestScore = ~0ull;
+			uint8_t bestFilter = 0;
+			for (uint8_t filter = 0; filter <= 4; filter++)
+			{
+				uint64_t score = 0;
+				for (size_t x = 0; x < stride; x++)
+				{
+					int a = x >= 4 ? row[x - 4] : 0;
+					int b = up ? up[x] : 0;
+					int c = up && x >= 4 ? up[x - 4] : 0;
+					uint8_t predicted = filter == 0 ? 0 : filter == 1 ? (uint8_t)a : filter == 2 ? (uint8_t)b : filter == 3 ? (uint8_t)((a + b) / 2) : paeth(a, b, c);
+					candidate[x] = (uint8_t)(row[x] - predicted);
+					score += candidate[x] < 128 ? candidate[x] : 256 - candidate[x];
+				}
+				if (score < bestScore)
+				{
+					bestScore = score;
+					bestFilter = filter;
+					best.swap(candidate);
+				}
+			}
+			out.push_back(bestFilter);
+			out.insert(out.end(), best.begin(), best.end());
+		}
+		return out;
+	}
+
+	void writeChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data)
+	{
+		uint32_t size = (uint32_t)data.size();
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			png.push_back((uint8_t)(size >> shift));
+		}
+		size_t start = png.size();
+		png.insert(png.end(), type, type + 4);
+		png.insert(png.end(), data.begin(), data.end());
+		uint32_t crc = crc32(&png[start], png.size() - start);
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			png.push_back((uint8_t)(crc >> shift));
+		}
+	}
+}
+
+std::vector<uint8_t> encodePng(const uint8_t *rgba, int width, int height)
+{
+	const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	std::vector<uint8_t> png(signature, signature + 8);
+
+	std::vector<uint8_t> header;
+	for (uint32_t value : { (uint32_t)width, (uint32_t)height })
+	{
+		for (int shift = 24; shift >= 0; shift -= 8)
+		{
+			header.push_back((uint8_t)(value >> shift));
+		}
+	}
+	header.push_back(8); // bits por canal
+	header.push_back(6); // RGBA
+	header.push_back(0); // deflate
+	header.push_back(0); // filtros adaptativos
+	header.push_back(0); // sem entrelaçamento
+	writeChunk(png, "IHDR", header);
+	writeChunk(png, "IDAT", zlibCompress(filterRows(rgba, width, height)));
+	writeChunk(png, "IEND", std::vector<uint8_t>());
+	return png;
+}
+
+bool writePng(const char *path, const uint8_t *rgba, int width, int height)
+{
+	std::vector<uint8_t> png = encodePng(rgba, width, height);
+	FILE *file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	bool written = fwrite(png.data(), 1, png.size(), file) == png.size();
+	return fclose(file) == 0 && written;
+}
@@ -0,0 +1,142 @@
+#include "Profiler.h"
+
+#include <cstdio>
+
+Profiler profiler;
+
+namespace
+{
+	// Anel da thread atual; as threads nunca trocam de profiler, então basta um ponteiro
+	thread_local ProfileRing *currentRing = nullptr;
+
+	// Os nomes são literais do código, mas aspas e barras quebrariam o JSON
+	void writeJsonString(FILE *file, const char *text)
+	{
+		fputc('"', file);
+		for (const char *c = text; *c; c++)
+		{
+			if (*c == '"' || *c == '\\')
+			{
+				fputc('\\', file);
+			}
+			fputc((unsigned char)*c < 0x20 ? ' ' : *c, file);
+		}
+		fputc('"', file);
+	}
+}
+
+Profiler::Profiler() : origin(std::chrono::steady_clock::now()), enabled(true)
+{
+	gpuRing = addRing("GPU");
+}
+
+ProfileRing *Profiler::addRing(const char *name)
+{
+	std::lock_guard<std::mutex> guard(ringsLock);
+	std::unique_ptr<ProfileRing> ring(new ProfileRing());
+	ring->id = (uint32_t)rings.size();
+	ring->threadName = name;
+	ring->written.store(0, std::memory_order_relaxed);
+	rings.push_back(std::move(ring));
+	return rings.back().get();
+}
+
+ProfileRing *Profiler::threadRing()
+{
+	if (currentRing == nullptr)
+	{
+		currentRing = addRing(nullptr);
+	}
+	return currentRing;
+}
+
+void Profiler::setThreadName(const char *name)
+{
+	ProfileRing *ring = threadRing();
+	std::lock_guard<std::mutex> guard(ringsLock);
+	ring->threadName = name;
+}
+
+static void writeEvent(ProfileRing *ring, const char *name, int64_t start, int64_t end)
+{
+	uint64_t index = ring->written.load(std::memory_order_relaxed);
+	ProfileEvent &event = ring->events[index % ProfileRing::CAPACITY];
+	event.name.store(name, std::memory_order_relaxed);
+	event.start.store(start, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	ring->written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::record(const char *name, int64_t start, int64_t end)
+{
+	if (isEnabled())
+	{
+		writeEvent(threadRing(), name, start, end);
+	}
+}
+
+void Profiler::recordGpu(const char *name, int64_t start, int64_t end)
+{
+	if (isEnabled())
+	{
+		writeEvent(gpuRing, name, start, end);
+	}
+}
+
+bool Profiler::writeChromeTrace(const char *path)
+{
+	FILE *file = fopen(path, "w");
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(ringsLock);
+	fprintf(file, "{\"traceEvents\":[\n");
+	bool first = true;
+	for (const std::unique_ptr<ProfileRing> &ring : rings)
+	{
+		// Nome da thread (metadado)
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", ring->id);
+		if (ring->threadName != nullptr)
+		{
+			writeJsonString(file, ring->threadName);
+		}
+		else
+		{
+			fprintf(file, "\"thread %u\"", ring->id);
+		}
+		fprintf(file, "}}");
+		first = false;
+
+		uint64_t written = ring->written.load(std::memory_order_acquire);
+		uint64_t begin = written > ProfileRing::CAPACITY ? written - ProfileRing::CAPACITY : 0;
+		std::vector<int64_t> starts, ends;
+		std::vector<const char *> names;
+		for (uint64_t i = begin; i < written; i++)
+		{
+			const ProfileEvent &event = ring->events[i % ProfileRing::CAPACITY];
+			names.push_back(event.name.load(std::memory_order_relaxed));
+			starts.push_back(event.start.load(std::memory_order_relaxed));
+			ends.push_back(event.end.load(std::memory_order_relaxed));
+		}
+
+		// A thread pode ter sobrescrito o começo da cópia enquanto copiávamos
+		std::atomic_thread_fence(std::memory_order_acquire);
+		uint64_t after = ring->written.load(std::memory_order_relaxed);
+		uint64_t valid = after >= ProfileRing::CAPACITY ? after - ProfileRing::CAPACITY + 1 : 0;
+		for (uint64_t i = begin; i < written; i++)
+		{
+			if (i < valid)
+			{
+				continue;
+			}
+			size_t k = (size_t)(i - begin);
+			fprintf(file, ",\n{\"name\":");
+			writeJsonString(file, names[k]);
+			fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ring->id, starts[k] / 1000.0, (ends[k] - starts[k]) / 1000.0);
+		}
+	}
+	fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+	return fclose(file) == 0;
+}
@@ -0,0 +1,193 @@
+#include "RenderStats.h"
+
+#include <glad/glad.h>
+#include <cstdio>
+
+namespace
+{
+	RenderStats current = {};
+	RenderStats last = {};
+	bool inFrame = false;  // entre beginRenderStats e endRenderStats
+	bool paused = false;
+	bool counting = false; // inFrame && !paused, testado em cada chamada
+	bool installed = false;
+
+	uint64_t trianglesOf(GLenum mode, GLsizei count)
+	{
+		if (mode == GL_TRIANGLES)
+		{
+			return count / 3;
+		}
+		if (mode == GL_TRIANGLE_STRIP || mode == GL_TRIANGLE_FAN)
+		{
+			return count >= 3 ? count - 2 : 0;
+		}
+		return 0;
+	}
+
+	void countDraw(GLenum mode, GLsizei count, GLsizei instances)
+	{
+		current.drawCalls++;
+		current.instances += instances;
+		current.triangles += trianglesOf(mode, count) * instances;
+	}
+
+	// Aproximado: ignora o alinhamento de linha do GL_UNPACK_ALIGNMENT
+	uint64_t pixelBytes(GLsizei width, GLsizei height, GLenum format, GLenum type)
+	{
+		uint64_t channels = 4;
+		switch (format)
+		{
+		case GL_RED:
+			channels = 1;
+			break;
+		case GL_RG:
+			channels = 2;
+			break;
+		case GL_RGB:
+		case GL_BGR:
+			channels = 3;
+			break;
+		}
+		uint64_t channelBytes = type == GL_FLOAT ? 4 : type == GL_UNSIGNED_SHORT || type == GL_HALF_FLOAT ? 2 : 1;
+		return (uint64_t)width * height * channels * channelBytes;
+	}
+}
+
+// Cada versão contada guarda a original, soma no frame (se contando) e repassa a chamada
+#define COUNTED(fn, params, args, count)              \
+	namespace                                         \
+	{                                                 \
+		decltype(glad_gl##fn) original##fn = nullptr; \
+		void APIENTRY counted##fn params              \
+		{                                             \
+			if (counting)                             \
+			{                                         \
+				count;                                \
+			}                                         \
+			original##fn args;                        \
+		}                                             \
+	}
+
+COUNTED(DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count), countDraw(mode, count, 1))
+COUNTED(DrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instances), (mode, first, count, instances), countDraw(mode, count, instances))
+COUNTED(DrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices), countDraw(mode, count, 1))
+COUNTED(DrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instances), (mode, count, type, indices, instances), countDraw(mode, count, instances))
+
+COUNTED(BindTexture, (GLenum target, GLuint texture), (target, texture), current.textureBinds++)
+COUNTED(BindBuffer, (GLenum target, GLuint buffer), (target, buffer), current.bufferBinds++)
+COUNTED(BindVertexArray, (GLuint array), (array), current.vertexArrayBinds++)
+COUNTED(UseProgram, (GLuint program), (program), current.programBinds++)
+
+COUNTED(Uniform1i, (GLint location, GLint v0), (location, v0), current.uniformUploads++)
+COUNTED(Uniform1f, (GLint location, GLfloat v0), (location, v0), current.uniformUploads++)
+COUNTED(Uniform2f, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1), current.uniformUploads++)
+COUNTED(Uniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2), current.uniformUploads++)
+COUNTED(Uniform4f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3), current.uniformUploads++)
+COUNTED(Uniform1fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value), current.uniformUploads++)
+COUNTED(Uniform2fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value), current.uniformUploads++)
+COUNTED(Uniform4fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value), current.uniformUploads++)
+COUNTED(UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value), current.uniformUploads++)
+
+// Sem dados, glBufferData só (re)aloca: não conta como envio
+COUNTED(BufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage), (target, size, data, usage), current.bytesUploaded += data ? size : 0)
+COUNTED(BufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), (target, offset, size, data), current.bytesUploaded += size)
+COUNTED(TexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels),
+		(target, level, internalformat, width, height, border, format, type, pixels), current.bytesUploaded += pixels ? pixelBytes(width, height, format, type) : 0)
+COUNTED(TexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels),
+		(target, level, xoffset, yoffset, width, height, format, type, pixels), current.bytesUploaded += pixelBytes(width, height, format, type))
+
+namespace
+{
+	// Devolve um ponteiro: não cabe no COUNTED. A faixa mapeada para escrita conta como enviada inteira
+	decltype(glad_glMapBufferRange) originalMapBufferRange = nullptr;
+	void *APIENTRY countedMapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+	{
+		if (counting && (access & GL_MAP_WRITE_BIT))
+		{
+			current.bytesUploaded += length;
+		}
+		return originalMapBufferRange(target, offset, length, access);
+	}
+}
+
+// Funções ausentes no contexto (ponteiro nulo) ficam como estão
+#define INSTALL(fn)                        \
+	if (glad_gl##fn != nullptr)            \
+	{                                      \
+		original##fn = glad_gl##fn;        \
+		glad_gl##fn = counted##fn;         \
+	}
+
+void installRenderStats()
+{
+	if (installed)
+	{
+		return;
+	}
+	INSTALL(DrawArrays)
+	INSTALL(DrawArraysInstanced)
+	INSTALL(DrawElements)
+	INSTALL(DrawElementsInstanced)
+	INSTALL(BindTexture)
+	INSTALL(BindBuffer)
+	INSTALL(BindVertexArray)
+	INSTALL(UseProgram)
+	INSTALL(Uniform1i)
+	INSTALL(Uniform1f)
+	INSTALL(Uniform2f)
+	INSTALL(Uniform3f)
+	INSTALL(Uniform4f)
+	INSTALL(Uniform1fv)
+	INSTALL(Uniform2fv)
+	INSTALL(Uniform4fv)
+	INSTALL(UniformMatrix4fv)
+	INSTALL(BufferData)
+	INSTALL(BufferSubData)
+	INSTALL(TexImage2D)
+	INSTALL(TexSubImage2D)
+	INSTALL(MapBufferRange)
+	installed = true;
+}
+
+void beginRenderStats()
+{
+	current = RenderStats();
+	inFrame = true;
+	counting = !paused;
+}
+
+const RenderStats &endRenderStats(double frameMs, double cpuMs, double gpuMs)
+{
+	inFrame = false;
+	counting = false;
+	current.frameMs = frameMs;
+	current.cpuMs = cpuMs;
+	current.gpuMs = gpuMs;
+	last = current;
+	return last;
+}
+
+void pauseRenderStats(bool pause)
+{
+	paused = pause;
+	counting = inFrame && !paused;
+}
+
+const RenderStats &lastRenderStats()
+{
+	return last;
+}
+
+int formatRenderStats(const RenderStats &stats, char *text, size_t size)
+{
+	return snprintf(text, size,
+					"frame %.2f ms  cpu %.2f ms  gpu %.2f ms\n"
+					"draws %u  instancias %llu  triangulos %llu\n"
+					"binds: textura %u  buffer %u  vao %u  programa %u\n"
+					"uniforms %u  enviados %.1f KB",
+					stats.frameMs, stats.cpuMs, stats.gpuMs,
+					stats.drawCalls, (unsigned long long)stats.instances, (unsigned long long)stats.triangles,
+					stats.textureBinds, stats.bufferBinds, stats.vertexArrayBinds, stats.programBinds,
+					stats.uniformUploads, stats.bytesUploaded / 1024.0);
+}
@@ -0,0 +1,209 @@
+#include "ScriptScheduler.h"
+
+#include <algorithm>
+#include <new>
+
+namespace
+{
+	const size_t FRAME_CLASS = 64;      // granularidade das classes de tamanho
+	const size_t NUM_CLASSES = 16;      // frames de até 1 KB vêm do pool
+	const size_t FRAMES_PER_BLOCK = 64; // frames reservados de uma vez por classe
+
+	struct FreeFrame
+	{
+		FreeFrame *next;
+	};
+
+	struct FramePool
+	{
+		FreeFrame *freeLists[NUM_CLASSES] = {};
+		std::vector<void *> blocks;
+		ScriptFrameStats stats = {};
+
+		~FramePool()
+		{
+			for (void *block : blocks)
+			{
+				::operator delete(block);
+			}
+		}
+	};
+
+	thread_local FramePool pool;
+
+	// Ordem do heap de timers: o topo é o que acorda primeiro
+	struct LaterTimer
+	{
+		template <class T>
+		bool operator()(const T &a, const T &b) const
+		{
+			return a.wakeTick != b.wakeTick ? a.wakeTick > b.wakeTick : a.sequence > b.sequence;
+		}
+	};
+}
+
+void *scriptFrameAllocate(size_t size)
+{
+	size_t sizeClass = (size + FRAME_CLASS - 1) / FRAME_CLASS - 1;
+	if (sizeClass >= NUM_CLASSES)
+	{
+		pool.stats.heapFrames++;
+		return ::operator new(size);
+	}
+
+	FreeFrame *&freeList = pool.freeLists[sizeClass];
+	if (freeList == nullptr)
+	{
+		// Reserva um bloco e encadeia os frames dele na lista livre
+		size_t frameSize = (sizeClass + 1) * FRAME_CLASS;
+		char *block = (char *)::operator new(frameSize * FRAMES_PER_BLOCK);
+		pool.blocks.push_back(block);
+		pool.stats.reservedBytes += frameSize * FRAMES_PER_BLOCK;
+		for (size_t i = FRAMES_PER_BLOCK; i-- > 0;)
+		{
+			FreeFrame *frame = (FreeFrame *)(block + i * frameSize);
+			frame->next = freeList;
+			freeList = frame;
+		}
+	}
+
+	FreeFrame *frame = freeList;
+	freeList = frame->next;
+	pool.stats.inUse++;
+	return frame;
+}
+
+void scriptFrameRelease(void *frame, size_t size)
+{
+	size_t sizeClass = (size + FRAME_CLASS - 1) / FRAME_CLASS - 1;
+	if (sizeClass >= NUM_CLASSES)
+	{
+		pool.stats.heapFrames--;
+		::operator delete(frame);
+		return;
+	}
+
+	FreeFrame *free = (FreeFrame *)frame;
+	free->next = pool.freeLists[sizeClass];
+	pool.freeLists[sizeClass] = free;
+	pool.stats.inUse--;
+}
+
+ScriptFrameStats scriptFrameStats()
+{
+	return pool.stats;
+}
+
+Script::promise_type::~promise_type()
+{
+	if (waitingOn != nullptr)
+	{
+		waitingOn->remove(Script::Handle::from_promise(*this));
+	}
+}
+
+ScriptScheduler::~ScriptScheduler()
+{
+	// Scripts ainda suspensos (esperando tick ou evento) morrem com o scheduler
+	while (live != nullptr)
+	{
+		Script::promise_type *promise = live;
+		live = promise->next;
+		Script::Handle::from_promise(*promise).destroy();
+	}
+}
+
+void ScriptScheduler::spawn(Script script)
+{
+	Script::Handle h = script.handle;
+	script.handle = nullptr;
+
+	Script::promise_type &promise = h.promise();
+	promise.scheduler = this;
+	promise.prev = nullptr;
+	promise.next = live;
+	if (live != nullptr)
+	{
+		live->prev = &promise;
+	}
+	live = &promise;
+	liveCount++;
+
+	ready.push_back(h);
+}
+
+void ScriptScheduler::sleep(Script::Handle h, uint32_t delay)
+{
+	// O caso comum (próximo tick) vai direto para a lista de prontos
+	if (delay == 1)
+	{
+		ready.push_back(h);
+		return;
+	}
+	if (delay < WHEEL_SIZE)
+	{
+		wheel[(ticks + delay) % WHEEL_SIZE].push_back(h);
+		return;
+	}
+	timers.push_back(Timer{ticks + delay, sequence++, h});
+	std::push_heap(timers.begin(), timers.end(), LaterTimer());
+}
+
+void ScriptScheduler::tick()
+{
+	ticks++;
+
+	// Timers vencidos entram depois dos já prontos, em ordem de agendamento
+	std::vector<Script::Handle> &slot = wheel[ticks % WHEEL_SIZE];
+	ready.insert(ready.end(), slot.begin(), slot.end());
+	slot.clear();
+	while (!timers.empty() && timers.front().wakeTick <= ticks)
+	{
+		std::pop_heap(timers.begin(), timers.end(), LaterTimer());
+		ready.push_back(timers.back().handle);
+		timers.pop_back();
+	}
+
+	// O que for agendado durante o lote (waitNextTick, sinais) vai para ready e roda no próximo tick
+	running.swap(ready);
+	for (Script::Handle h : running)
+	{
+		h.resume();
+		if (h.done())
+		{
+			Script::promise_type &promise = h.promise();
+			if (promise.prev != nullptr)
+			{
+				promise.prev->next = promise.next;
+			}
+			else
+			{
+				live = promise.next;
+			}
+			if (promise.next != nullptr)
+			{
+				promise.next->prev = promise.prev;
+			}
+			liveCount--;
+			h.destroy();
+		}
+	}
+	running.clear();
+}
+
+void ScriptEvent::signal()
+{
+	// Troca antes de acordar: quem voltar a esperar entra na lista nova
+	signaled.swap(waiters);
+	for (Script::Handle h : signaled)
+	{
+		h.promise().waitingOn = nullptr;
+		h.promise().scheduler->wake(h);
+	}
+	signaled.clear();
+}
+
+void ScriptEvent::remove(Script::Handle h)
+{
+	waiters.erase(std::find(waiters.begin(), waiters.end(), h));
+}
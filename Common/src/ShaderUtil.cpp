@@ -0,0 +1,55 @@
+#include "ShaderUtil.h"
+
+#include <iostream>
+
+namespace
+{
+	// Devolve 0 se não compilar; o log vai para o terminal
+	GLuint compileShader(GLenum type, const GLchar *source, const char *name)
+	{
+		GLuint shader = glCreateShader(type);
+		glShaderSource(shader, 1, &source, NULL);
+		glCompileShader(shader);
+		GLint success;
+		glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+		if (!success)
+		{
+			GLchar infoLog[512];
+			glGetShaderInfoLog(shader, 512, NULL, infoLog);
+			std::cout << "ERROR::SHADER::" << name << "::COMPILATION_FAILED\n" << infoLog << std::endl;
+			glDeleteShader(shader);
+			return 0;
+		}
+		return shader;
+	}
+}
+
+GLuint buildProgram(const GLchar *vertexSource, const GLchar *fragmentSource)
+{
+	GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, "VERTEX");
+	GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, "FRAGMENT");
+	if (vertexShader == 0 || fragmentShader == 0)
+	{
+		glDeleteShader(vertexShader);
+		glDeleteShader(fragmentShader);
+		return 0;
+	}
+	GLuint program = glCreateProgram();
+	glAttachShader(program, vertexShader);
+	glAttachShader(program, fragmentShader);
+	glLinkProgram(program);
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	GLint success;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	if (!success)
+	{
+		GLchar infoLog[512];
+		glGetProgramInfoLog(program, 512, NULL, infoLog);
+		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+		glDeleteProgram(program);
+		return 0;
+	}
+	return program;
+}
@@ -0,0 +1,133 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize, float minX, float minY, float maxX, float maxY)
+	: originX(minX), originY(minY), invCellSize(1.0f / cellSize), count(0)
+{
+	cellsX = std::max(1u, (uint32_t)std::ceil((maxX - minX) * invCellSize));
+	cellsY = std::max(1u, (uint32_t)std::ceil((maxY - minY) * invCellSize));
+	cellStart.assign(cellsX * cellsY + 1, 0);
+	cellCursor.assign(cellsX * cellsY, 0);
+	boxes = AABBColumns{ nullptr, nullptr, nullptr, nullptr };
+}
+
+uint32_t SpatialGrid::cellX(float x) const
+{
+	float c = (x - originX) * invCellSize;
+	if (c <= 0.0f)
+	{
+		return 0;
+	}
+	return std::min((uint32_t)c, cellsX - 1);
+}
+
+uint32_t SpatialGrid::cellY(float y) const
+{
+	float c = (y - originY) * invCellSize;
+	if (c <= 0.0f)
+	{
+		return 0;
+	}
+	return std::min((uint32_t)c, cellsY - 1);
+}
+
+SpatialGrid::CellRange SpatialGrid::rangeOf(float minX, float minY, float maxX, float maxY) const
+{
+	CellRange range = { cellX(minX), cellY(minY), cellX(maxX), cellY(maxY) };
+	return range;
+}
+
+void SpatialGrid::build(AABBColumns columns, uint32_t n)
+{
+	boxes = columns;
+	count = n;
+	std::fill(cellStart.begin(), cellStart.end(), 0);
+
+	// 1. Contagem: quantas entradas cada célula recebe (deslocado de 1 para a soma de prefixos)
+	uint32_t total = 0;
+	for (uint32_t i = 0; i < n; i++)
+	{
+		CellRange r = rangeOf(boxes.minX[i], boxes.minY[i], boxes.maxX[i], boxes.maxY[i]);
+		for (uint32_t y = r.y0; y <= r.y1; y++)
+		{
+			for (uint32_t x = r.x0; x <= r.x1; x++)
+			{
+				cellStart[y * cellsX + x + 1]++;
+			}
+		}
+		total += (r.x1 - r.x0 + 1) * (r.y1 - r.y0 + 1);
+	}
+
+	// 2. Soma de prefixos: início de cada célula
+	uint32_t cells = cellsX * cellsY;
+	for (uint32_t c = 0; c < cells; c++)
+	{
+		cellStart[c + 1] += cellStart[c];
+	}
+
+	// 3. Preenchimento, em ordem crescente de índice dentro de cada célula
+	entries.resize(total);
+	std::copy(cellStart.begin(), cellStart.end() - 1, cellCursor.begin());
+	for (uint32_t i = 0; i < n; i++)
+	{
+		CellRange r = rangeOf(boxes.minX[i], boxes.minY[i], boxes.maxX[i], boxes.maxY[i]);
+		for (uint32_t y = r.y0; y <= r.y1; y++)
+		{
+			for (uint32_t x = r.x0; x <= r.x1; x++)
+			{
+				entries[cellCursor[y * cellsX + x]++] = i;
+			}
+		}
+	}
+}
+
+void SpatialGrid::findPairs(std::vector<CandidatePair> &pairs) const
+{
+	pairs.clear();
+	uint32_t cells = cellsX * cellsY;
+	for (uint32_t c = 0; c < cells; c++)
+	{
+		uint32_t begin = cellStart[c], end = cellStart[c + 1];
+		for (uint32_t p = begin; p < end; p++)
+		{
+			uint32_t i = entries[p];
+			for (uint32_t q = p + 1; q < end; q++)
+			{
+				uint32_t j = entries[q];
+				// Um par que divide várias células só é emitido na célula do canto mínimo da interseção
+				uint32_t owner = cellY(std::max(boxes.minY[i], boxes.minY[j])) * cellsX + cellX(std::max(boxes.minX[i], boxes.minX[j]));
+				if (owner == c)
+				{
+					CandidatePair pair = { i, j };
+					pairs.push_back(pair);
+				}
+			}
+		}
+	}
+}
+
+uint32_t SpatialGrid::query(AABB box, uint32_t *out) const
+{
+	uint32_t n = 0;
+	CellRange r = rangeOf(box.minX, box.minY, box.maxX, box.maxY);
+	for (uint32_t y = r.y0; y <= r.y1; y++)
+	{
+		for (uint32_t x = r.x0; x <= r.x1; x++)
+		{
+			uint32_t c = y * cellsX + x;
+			for (uint32_t p = cellStart[c]; p < cellStart[c + 1]; p++)
+			{
+				uint32_t j = entries[p];
+				// Mesma regra de dono dos pares, para não repetir entidades que cobrem várias células
+				uint32_t owner = cellY(std::max(box.minY, boxes.minY[j])) * cellsX + cellX(std::max(box.minX, boxes.minX[j]));
+				if (owner == c)
+				{
+					out[n++] = j;
+				}
+			}
+		}
+	}
+	return n;
+}
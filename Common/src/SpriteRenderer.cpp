@@ -0,0 +1,208 @@
+#include "SpriteRenderer.h"
+
+#include <cstddef>
+#include "Profiler.h"
+#include "ShaderUtil.h"
+
+namespace
+{
+	// Sem rotação: Transform2D<false>, translação e escala num só vec4
+	const GLchar *VERTEX_SHADER = R"(
+		#version 400
+		layout (location = 0) in vec3 coordenadasDaGeometria;
+		layout (location = 1) in vec2 coordenadasDaTextura;
+		layout (location = 2) in vec4 instanceTransform;	// xy: centro do sprite, zw: escala
+		layout (location = 4) in vec4 instanceUV;			// u0, v0, du, dv do quadro na spritesheet
+		layout (location = 5) in vec4 instanceTint;
+		uniform mat4 projection;
+		out vec2 textureCoord;
+		out vec4 tint;
+		void main() {
+			vec2 position = instanceTransform.xy + instanceTransform.zw * coordenadasDaGeometria.xy;
+   			gl_Position = projection * vec4( position , 0.0 , 1.0 );
+			textureCoord = vec2( instanceUV.x + coordenadasDaTextura.s * instanceUV.z , instanceUV.y + 1.0 - coordenadasDaTextura.t * instanceUV.w );
+			tint = instanceTint;
+		}
+	)";
+
+	// Com rotação: Transform2D<true>, a matriz 2x3
+	const GLchar *ROTATING_VERTEX_SHADER = R"(
+		#version 400
+		layout (location = 0) in vec3 coordenadasDaGeometria;
+		layout (location = 1) in vec2 coordenadasDaTextura;
+		layout (location = 2) in vec4 instanceBasis;		// colunas da matriz 2x2 (rotação * escala)
+		layout (location = 3) in vec2 instanceTranslation;	// centro do sprite
+		layout (location = 4) in vec4 instanceUV;			// u0, v0, du, dv do quadro na spritesheet
+		layout (location = 5) in vec4 instanceTint;
+		uniform mat4 projection;
+		out vec2 textureCoord;
+		out vec4 tint;
+		void main() {
+			vec2 position = instanceTranslation + mat2(instanceBasis.xy, instanceBasis.zw) * coordenadasDaGeometria.xy;
+   			gl_Position = projection * vec4( position , 0.0 , 1.0 );
+			textureCoord = vec2( instanceUV.x + coordenadasDaTextura.s * instanceUV.z , instanceUV.y + 1.0 - coordenadasDaTextura.t * instanceUV.w );
+			tint = instanceTint;
+		}
+	)";
+
+	const GLchar *FRAGMENT_SHADER = R"(
+		#version 400
+		in vec2 textureCoord;
+		in vec4 tint;
+		uniform sampler2D textureBuffer;
+		out vec4 color;
+		void main() { color = texture(textureBuffer,textureCoord) * tint; }
+	)";
+}
+
+SpriteRenderer::SpriteRenderer(uint32_t layerCount, uint32_t maxInstances, bool rotation)
+	: maxInstances(maxInstances), rotation(rotation), instanceSize(rotation ? sizeof(SpriteInstance<true>) : sizeof(SpriteInstance<false>)),
+	  builder(layerCount), program(0), vao(0), quadVBO(0), instanceVBO(0), projectionLocation(-1)
+{
+}
+
+bool SpriteRenderer::init()
+{
+	program = buildProgram(rotation ? ROTATING_VERTEX_SHADER : VERTEX_SHADER, FRAGMENT_SHADER);
+	if (program == 0)
+	{
+		return false;
+	}
+	projectionLocation = glGetUniformLocation(program, "projection");
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "textureBuffer"), 0);
+
+	// Quad unitário centrado na origem; a textura vai de 0 a 1 e o retângulo de UV vem de cada instância
+	GLfloat vertices[] = {
+		-0.5,  0.5, 0.0, 0.0, 1.0,
+		-0.5, -0.5, 0.0, 0.0, 0.0,
+		 0.5,  0.5, 0.0, 1.0, 1.0,
+
+		-0.5, -0.5, 0.0, 0.0, 0.0,
+		 0.5,  0.5, 0.0, 1.0, 1.0,
+		 0.5, -0.5, 0.0, 1.0, 0.0
+	};
+
+	glGenBuffers(1, &quadVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	//Atributo posição - coord x, y, z - 3 valores
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid *)0);
+	glEnableVertexAttribArray(0);
+
+	//Atributo coordenada de textura - coord s, t - 2 valores
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid *)(3 * sizeof(GLfloat)));
+	glEnableVertexAttribArray(1);
+
+	// Buffer de instâncias: reescrito inteiro a cada frame
+	glGenBuffers(1, &instanceVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, maxInstances * instanceSize, NULL, GL_STREAM_DRAW);
+	for (GLuint location = 2; location <= 5; location++)
+	{
+		if (location == 3 && !rotation)
+		{
+			continue; // a translação já está no vec4 da localização 2
+		}
+		glEnableVertexAttribArray(location);
+		glVertexAttribDivisor(location, 1); // avança uma vez por instância, não por vértice
+	}
+	bindInstanceAttributes(0);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	return true;
+}
+
+void SpriteRenderer::shutdown()
+{
+	if (program == 0)
+	{
+		return;
+	}
+	glDeleteVertexArrays(1, &vao);
+	glDeleteBuffers(1, &quadVBO);
+	glDeleteBuffers(1, &instanceVBO);
+	glDeleteProgram(program);
+	program = 0;
+}
+
+void SpriteRenderer::setProjection(const float *matrix)
+{
+	glUseProgram(program);
+	glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, matrix);
+}
+
+void SpriteRenderer::bindInstanceAttributes(uint32_t firstInstance)
+{
+	// Aponta os atributos de instância para a primeira instância de uma camada (a GL 4.0 não tem base instance)
+	const GLsizei stride = (GLsizei)instanceSize;
+	const char *base = (const char *)(firstInstance * instanceSize);
+	if (rotation)
+	{
+		typedef SpriteInstance<true> Instance;
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(Instance, transform) + offsetof(Transform2D<true>, basis)));
+		glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(Instance, transform) + offsetof(Transform2D<true>, translation)));
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(Instance, uv)));
+		glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid *)(base + offsetof(Instance, tint)));
+	}
+	else
+	{
+		typedef SpriteInstance<false> Instance;
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(Instance, transform)));
+		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid *)(base + offsetof(Instance, uv)));
+		glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid *)(base + offsetof(Instance, tint)));
+	}
+}
+
+void SpriteRenderer::draw(JobSystem &jobs, const InstanceSprite *sprites, uint32_t count, const GLuint *layerTextures)
+{
+	count = count < maxInstances ? count : maxInstances;
+	if (count == 0)
+	{
+		return;
+	}
+
+	glUseProgram(program);
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+	// Os workers escrevem as instâncias direto no buffer; INVALIDATE evita esperar a GPU largar o frame anterior
+	void *mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, count * instanceSize, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (mapped)
+	{
+		{
+			PROFILE_ZONE("build instances");
+			if (rotation)
+			{
+				builder.build(jobs, sprites, count, (SpriteInstance<true> *)mapped);
+			}
+			else
+			{
+				builder.build(jobs, sprites, count, (SpriteInstance<false> *)mapped);
+			}
+			glUnmapBuffer(GL_ARRAY_BUFFER);
+		}
+
+		// Esta thread só faz os draws: um por camada, na ordem das camadas
+		for (uint32_t layer = 0; layer < builder.layerCount(); layer++)
+		{
+			uint32_t n = builder.layerSize(layer);
+			if (n == 0)
+			{
+				continue;
+			}
+			glBindTexture(GL_TEXTURE_2D, layerTextures[layer]);
+			bindInstanceAttributes(builder.layerStart(layer));
+			glDrawArraysInstanced(GL_TRIANGLES, 0, 6, n);
+		}
+	}
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);			 // Desconectando ao buffer de geometria
+	glBindTexture(GL_TEXTURE_2D, 0); // Desconectando com o buffer de textura
+}
@@ -0,0 +1,81 @@
+#include "SpriteStore.h"
+
+SpriteStore::SpriteStore(uint32_t capacity)
+	: posX(capacity), posY(capacity), velX(capacity), velY(capacity), halfW(capacity), halfH(capacity),
+	  minX(capacity), minY(capacity), maxX(capacity), maxY(capacity), iAnimation(capacity), iFrame(capacity),
+	  renderID(capacity), pool(capacity)
+{
+}
+
+EntityHandle SpriteStore::spawn()
+{
+	EntityHandle handle = pool.spawn();
+	if (handle == INVALID_ENTITY)
+	{
+		return handle;
+	}
+
+	uint32_t i = pool.denseIndex(handle);
+	posX[i] = posY[i] = 0.0f;
+	velX[i] = velY[i] = 0.0f;
+	halfW[i] = halfH[i] = 0.0f;
+	minX[i] = minY[i] = maxX[i] = maxY[i] = 0.0f;
+	iAnimation[i] = iFrame[i] = 0;
+	renderID[i] = 0;
+	return handle;
+}
+
+bool SpriteStore::despawn(EntityHandle handle)
+{
+	DenseMove move;
+	if (!pool.despawn(handle, move))
+	{
+		return false;
+	}
+	applyDenseMove(posX.data(), move);
+	applyDenseMove(posY.data(), move);
+	applyDenseMove(velX.data(), move);
+	applyDenseMove(velY.data(), move);
+	applyDenseMove(halfW.data(), move);
+	applyDenseMove(halfH.data(), move);
+	applyDenseMove(minX.data(), move);
+	applyDenseMove(minY.data(), move);
+	applyDenseMove(maxX.data(), move);
+	applyDenseMove(maxY.data(), move);
+	applyDenseMove(iAnimation.data(), move);
+	applyDenseMove(iFrame.data(), move);
+	applyDenseMove(renderID.data(), move);
+	return true;
+}
+
+void integrateMotion(SpriteStore &store, uint32_t first, uint32_t last)
+{
+	float *__restrict posX = store.posX.data();
+	float *__restrict posY = store.posY.data();
+	const float *__restrict velX = store.velX.data();
+	const float *__restrict velY = store.velY.data();
+
+	for (uint32_t i = first; i < last; i++)
+	{
+		posX[i] += velX[i];
+		posY[i] += velY[i];
+	}
+}
+
+void buildAABBs(SpriteStore &store, uint32_t first, uint32_t last)
+{
+	buildAABBBatch(store.posX.data() + first, store.posY.data() + first, store.halfW.data() + first, store.halfH.data() + first,
+				   store.minX.data() + first, store.minY.data() + first, store.maxX.data() + first, store.maxY.data() + first,
+				   last - first);
+}
+
+void advanceFrames(SpriteStore &store, const int32_t *nFramesByRenderID, uint32_t first, uint32_t last)
+{
+	int32_t *iFrame = store.iFrame.data();
+	const int32_t *renderID = store.renderID.data();
+
+	for (uint32_t i = first; i < last; i++)
+	{
+		iFrame[i] = (iFrame[i] + 1) % nFramesByRenderID[renderID[i]];
+	}
+}
@@ -0,0 +1,184 @@
+#include "SweptAABB.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if !defined(AABB_KERNELS_SCALAR) && defined(__AVX2__)
+#define SWEPT_AVX2
+#include <immintrin.h>
+#elif !defined(AABB_KERNELS_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SWEPT_SSE
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	// Deslocamentos menores que isso num eixo são tratados como parados nesse eixo
+	const float MIN_DELTA = 1e-8f;
+
+	inline uint32_t lowestBit(uint32_t bits)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, bits);
+		return (uint32_t)index;
+#else
+		return (uint32_t)__builtin_ctz(bits);
+#endif
+	}
+
+	// Intervalo [tMin, tMax] em que o centro fica dentro do slab [lo, hi] de um eixo
+	inline void slab(float lo, float hi, float c, float d, float &tMin, float &tMax)
+	{
+		if (std::fabs(d) < MIN_DELTA)
+		{
+			bool inside = c >= lo && c <= hi;
+			tMin = inside ? -INFINITY : INFINITY;
+			tMax = inside ? INFINITY : -INFINITY;
+			return;
+		}
+		float inv = 1.0f / d;
+		float t1 = (lo - c) * inv, t2 = (hi - c) * inv;
+		tMin = std::min(t1, t2);
+		tMax = std::max(t1, t2);
+	}
+
+#if defined(SWEPT_AVX2)
+	const uint32_t WIDTH = 8;
+
+	inline __m256 select(__m256 mask, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, mask); }
+
+	inline void slab8(__m256 lo, __m256 hi, __m256 c, __m256 d, __m256 &tMin, __m256 &tMax)
+	{
+		const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+		__m256 still = _mm256_cmp_ps(_mm256_and_ps(d, absMask), _mm256_set1_ps(MIN_DELTA), _CMP_LT_OQ);
+		__m256 safe = select(still, _mm256_set1_ps(1.0f), d);
+		__m256 inv = _mm256_rcp_ps(safe);
+		inv = _mm256_mul_ps(inv, _mm256_sub_ps(_mm256_set1_ps(2.0f), _mm256_mul_ps(safe, inv)));
+		__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(lo, c), inv);
+		__m256 t2 = _mm256_mul_ps(_mm256_sub_ps(hi, c), inv);
+		__m256 inside = _mm256_and_ps(_mm256_cmp_ps(c, lo, _CMP_GE_OQ), _mm256_cmp_ps(c, hi, _CMP_LE_OQ));
+		__m256 inf = _mm256_set1_ps(INFINITY), negInf = _mm256_set1_ps(-INFINITY);
+		tMin = select(still, select(inside, negInf, inf), _mm256_min_ps(t1, t2));
+		tMax = select(still, select(inside, inf, negInf), _mm256_max_ps(t1, t2));
+	}
+
+	inline uint32_t sweepLanes(const AABB &t, float tdx, float tdy, const SweptBatch &b, uint32_t i, float *toi)
+	{
+		__m256 hw = _mm256_loadu_ps(b.halfW + i), hh = _mm256_loadu_ps(b.halfH + i);
+		__m256 dx = _mm256_sub_ps(_mm256_loadu_ps(b.velX + i), _mm256_set1_ps(tdx));
+		__m256 dy = _mm256_sub_ps(_mm256_loadu_ps(b.velY + i), _mm256_set1_ps(tdy));
+		__m256 minX, maxX, minY, maxY;
+		slab8(_mm256_sub_ps(_mm256_set1_ps(t.minX), hw), _mm256_add_ps(_mm256_set1_ps(t.maxX), hw), _mm256_loadu_ps(b.posX + i), dx, minX, maxX);
+		slab8(_mm256_sub_ps(_mm256_set1_ps(t.minY), hh), _mm256_add_ps(_mm256_set1_ps(t.maxY), hh), _mm256_loadu_ps(b.posY + i), dy, minY, maxY);
+		__m256 enter = _mm256_max_ps(minX, minY), exit = _mm256_min_ps(maxX, maxY);
+		__m256 hit = _mm256_cmp_ps(enter, exit, _CMP_LE_OQ);
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(enter, _mm256_set1_ps(1.0f), _CMP_LE_OQ));
+		hit = _mm256_and_ps(hit, _mm256_cmp_ps(exit, _mm256_setzero_ps(), _CMP_GE_OQ));
+		_mm256_storeu_ps(toi, _mm256_max_ps(enter, _mm256_setzero_ps()));
+		return (uint32_t)_mm256_movemask_ps(hit);
+	}
+#elif defined(SWEPT_SSE)
+	const uint32_t WIDTH = 4;
+
+	inline __m128 select(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+	inline void slab4(__m128 lo, __m128 hi, __m128 c, __m128 d, __m128 &tMin, __m128 &tMax)
+	{
+		const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+		__m128 still = _mm_cmplt_ps(_mm_and_ps(d, absMask), _mm_set1_ps(MIN_DELTA));
+		// Recíproca aproximada + um passo de Newton-Raphson: ~22 bits, bem mais barata que a divisão
+		__m128 safe = select(still, _mm_set1_ps(1.0f), d);
+		__m128 inv = _mm_rcp_ps(safe);
+		inv = _mm_mul_ps(inv, _mm_sub_ps(_mm_set1_ps(2.0f), _mm_mul_ps(safe, inv)));
+		__m128 t1 = _mm_mul_ps(_mm_sub_ps(lo, c), inv);
+		__m128 t2 = _mm_mul_ps(_mm_sub_ps(hi, c), inv);
+		__m128 inside = _mm_and_ps(_mm_cmpge_ps(c, lo), _mm_cmple_ps(c, hi));
+		__m128 inf = _mm_set1_ps(INFINITY), negInf = _mm_set1_ps(-INFINITY);
+		tMin = select(still, select(inside, negInf, inf), _mm_min_ps(t1, t2));
+		tMax = select(still, select(inside, inf, negInf), _mm_max_ps(t1, t2));
+	}
+
+	inline uint32_t sweepLanes(const AABB &t, float tdx, float tdy, const SweptBatch &b, uint32_t i, float *toi)
+	{
+		__m128 hw = _mm_loadu_ps(b.halfW + i), hh = _mm_loadu_ps(b.halfH + i);
+		__m128 dx = _mm_sub_ps(_mm_loadu_ps(b.velX + i), _mm_set1_ps(tdx));
+		__m128 dy = _mm_sub_ps(_mm_loadu_ps(b.velY + i), _mm_set1_ps(tdy));
+		__m128 minX, maxX, minY, maxY;
+		slab4(_mm_sub_ps(_mm_set1_ps(t.minX), hw), _mm_add_ps(_mm_set1_ps(t.maxX), hw), _mm_loadu_ps(b.posX + i), dx, minX, maxX);
+		slab4(_mm_sub_ps(_mm_set1_ps(t.minY), hh), _mm_add_ps(_mm_set1_ps(t.maxY), hh), _mm_loadu_ps(b.posY + i), dy, minY, maxY);
+		__m128 enter = _mm_max_ps(minX, minY), exit = _mm_min_ps(maxX, maxY);
+		__m128 hit = _mm_cmple_ps(enter, exit);
+		hit = _mm_and_ps(hit, _mm_cmple_ps(enter, _mm_set1_ps(1.0f)));
+		hit = _mm_and_ps(hit, _mm_cmpge_ps(exit, _mm_setzero_ps()));
+		_mm_storeu_ps(toi, _mm_max_ps(enter, _mm_setzero_ps()));
+		return (uint32_t)_mm_movemask_ps(hit);
+	}
+#else
+	const uint32_t WIDTH = 1;
+
+	inline uint32_t sweepLanes(const AABB &t, float tdx, float tdy, const SweptBatch &b, uint32_t i, float *toi)
+	{
+		return sweptTOI(t, tdx, tdy, b.posX[i], b.posY[i], b.halfW[i], b.halfH[i], b.velX[i], b.velY[i], toi[0]) ? 1u : 0u;
+	}
+#endif
+}
+
+bool sweptTOI(AABB target, float targetDX, float targetDY, float posX, float posY, float halfW, float halfH,
+			  float velX, float velY, float &toi)
+{
+	float minX, maxX, minY, maxY;
+	slab(target.minX - halfW, target.maxX + halfW, posX, velX - targetDX, minX, maxX);
+	slab(target.minY - halfH, target.maxY + halfH, posY, velY - targetDY, minY, maxY);
+
+	float enter = std::max(minX, minY), exit = std::min(maxX, maxY);
+	toi = enter > 0.0f ? enter : 0.0f;
+	return enter <= exit && enter <= 1.0f && exit >= 0.0f;
+}
+
+uint32_t sweepAgainstBox(AABB target, float targetDX, float targetDY, SweptBatch items, uint32_t count,
+						 uint32_t *hits, float *hitTimes)
+{
+	uint32_t n = 0;
+	uint32_t i = 0;
+	float toi[8];
+	for (; i + WIDTH <= count; i += WIDTH)
+	{
+		for (uint32_t lanes = sweepLanes(target, targetDX, targetDY, items, i, toi); lanes; lanes &= lanes - 1)
+		{
+			uint32_t lane = lowestBit(lanes);
+			hits[n] = i + lane;
+			hitTimes[n] = toi[lane];
+			n++;
+		}
+	}
+	for (; i < count; i++)
+	{
+		float t;
+		if (sweptTOI(target, targetDX, targetDY, items.posX[i], items.posY[i], items.halfW[i], items.halfH[i], items.velX[i], items.velY[i], t))
+		{
+			hits[n] = i;
+			hitTimes[n] = t;
+			n++;
+		}
+	}
+	return n;
+}
+
+SweptHit earliestHit(const uint32_t *hits, const float *hitTimes, uint32_t n)
+{
+	SweptHit earliest = { NO_SWEPT_HIT, INFINITY };
+	for (uint32_t h = 0; h < n; h++)
+	{
+		if (hitTimes[h] < earliest.toi)
+		{
+			earliest.index = hits[h];
+			earliest.toi = hitTimes[h];
+		}
+	}
+	return earliest;
+}
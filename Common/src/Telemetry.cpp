@@ -0,0 +1,189 @@
+#include "Telemetry.h"
+
+#include <cstring>
+
+namespace
+{
+	const char MAGIC[8] = "PGTELEM";
+	const uint32_t BATCH = 256; // registros por fwrite
+
+	int64_t steadyNs()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+}
+
+Telemetry::~Telemetry()
+{
+	stop();
+}
+
+bool Telemetry::start(const char *path)
+{
+	if (running.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+	file = fopen(path, "wb");
+	if (file == nullptr)
+	{
+		return false;
+	}
+	TelemetryHeader header = {};
+	memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.recordSize = sizeof(TelemetryRecord);
+	fwrite(&header, sizeof(header), 1, file);
+
+	// Sobras de uma gravação anterior (eventos que chegaram depois do stop) não entram nesta; um
+	// recordEvent que já tinha passado pelo active pode empurrar mais uma depois daqui, com a sessão
+	// antiga, e o escritor descarta
+	TelemetryRecord stale;
+	while (frames.pop(stale) || events.pop(stale))
+	{
+	}
+	startNs.store(steadyNs(), std::memory_order_relaxed);
+	uint16_t current = (uint16_t)(session.fetch_add(1, std::memory_order_release) + 1); // publica startNs
+	frameCount.store(0, std::memory_order_relaxed);
+	written.store(0, std::memory_order_relaxed);
+	dropped.store(0, std::memory_order_relaxed);
+	running.store(true, std::memory_order_relaxed);
+	writer = std::thread(&Telemetry::writerLoop, this, current);
+	active.store(true, std::memory_order_release);
+	return true;
+}
+
+void Telemetry::stop()
+{
+	if (!running.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+	active.store(false, std::memory_order_relaxed);
+	running.store(false, std::memory_order_release);
+	writer.join(); // a thread escreve o que sobrou nas filas antes de sair
+	fclose(file);
+	file = nullptr;
+}
+
+void Telemetry::stamp(TelemetryRecord &record) const
+{
+	// A sessão vem antes do início: se ela já é a nova, startNs também é
+	record.session = (uint16_t)session.load(std::memory_order_acquire);
+	record.timeNs = (uint64_t)(steadyNs() - startNs.load(std::memory_order_relaxed));
+}
+
+void Telemetry::recordFrame(const TelemetryRecord &frame)
+{
+	if (!active.load(std::memory_order_acquire))
+	{
+		return;
+	}
+	TelemetryRecord record = frame;
+	stamp(record);
+	record.frame = frameCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	record.kind = TELEMETRY_FRAME;
+	record.value = 0;
+	if (!frames.push(record))
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+void Telemetry::recordEvent(TelemetryKind kind, int32_t value)
+{
+	if (!active.load(std::memory_order_acquire))
+	{
+		return;
+	}
+	TelemetryRecord record = {};
+	stamp(record);
+	record.frame = frameCount.load(std::memory_order_relaxed);
+	record.kind = kind;
+	record.value = value;
+	if (!events.push(record))
+	{
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+uint32_t Telemetry::drain(TelemetryRecord *batch, uint32_t size, uint16_t current)
+{
+	uint32_t count = 0;
+	while (count < size && events.pop(batch[count]))
+	{
+		count += batch[count].session == current;
+	}
+	while (count < size && frames.pop(batch[count]))
+	{
+		count += batch[count].session == current;
+	}
+	return count;
+}
+
+void Telemetry::writerLoop(uint16_t current)
+{
+	TelemetryRecord batch[BATCH];
+	for (;;)
+	{
+		// Lido antes de esvaziar as filas: o que foi gravado antes do stop ainda sai no último lote
+		bool stopping = !running.load(std::memory_order_acquire);
+		uint32_t count = drain(batch, BATCH, current);
+		if (count > 0)
+		{
+			fwrite(batch, sizeof(TelemetryRecord), count, file);
+			written.fetch_add(count, std::memory_order_relaxed);
+		}
+		else if (stopping)
+		{
+			fflush(file);
+			return;
+		}
+		else
+		{
+			// 60 Hz enchem um lote em ~4 s; acordar a cada 10 ms já é folga de sobra para a fila
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+	}
+}
+
+bool telemetryToCsv(const char *binaryPath, const char *csvPath)
+{
+	FILE *in = fopen(binaryPath, "rb");
+	if (in == nullptr)
+	{
+		return false;
+	}
+	TelemetryHeader header;
+	if (fread(&header, sizeof(header), 1, in) != 1 || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+		header.version != Telemetry::VERSION || header.recordSize != sizeof(TelemetryRecord))
+	{
+		fclose(in);
+		return false;
+	}
+	FILE *out = fopen(csvPath, "w");
+	if (out == nullptr)
+	{
+		fclose(in);
+		return false;
+	}
+
+	static const char *const KIND_NAMES[] = { "frame", "score", "lives", "wave", "gameover" };
+	fprintf(out, "time_ms,frame,kind,frame_ms,sim_ms,render_ms,gpu_ms,draw_calls,instances,entities,value\n");
+	TelemetryRecord record;
+	while (fread(&record, sizeof(record), 1, in) == 1)
+	{
+		const char *kind = record.kind <= TELEMETRY_GAMEOVER ? KIND_NAMES[record.kind] : "?";
+		if (record.kind == TELEMETRY_FRAME)
+		{
+			fprintf(out, "%.3f,%u,%s,%.3f,%.3f,%.3f,%.3f,%u,%u,%u,\n", record.timeNs / 1e6, record.frame, kind, record.frameMs, record.simMs,
+					record.renderMs, record.gpuMs, record.drawCalls, record.instances, record.entities);
+		}
+		else
+		{
+			fprintf(out, "%.3f,%u,%s,,,,,,,,%d\n", record.timeNs / 1e6, record.frame, kind, record.value);
+		}
+	}
+	fclose(in);
+	return fclose(out) == 0;
+}
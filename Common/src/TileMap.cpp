@@ -0,0 +1,244 @@
+#include "TileMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include "ShaderUtil.h"
+
+namespace
+{
+	const GLchar *VERTEX_SHADER = R"(
+		#version 400
+		layout (location = 0) in vec2 position;	// coordenadas do mundo
+		layout (location = 1) in vec2 uv;		// já dentro da célula do atlas
+		uniform mat4 projection;
+		out vec2 textureCoord;
+		void main() {
+			gl_Position = projection * vec4( position , 0.0 , 1.0 );
+			textureCoord = uv;
+		}
+	)";
+
+	const GLchar *FRAGMENT_SHADER = R"(
+		#version 400
+		in vec2 textureCoord;
+		uniform sampler2D textureBuffer;
+		out vec4 color;
+		void main() { color = texture(textureBuffer,textureCoord); }
+	)";
+
+	const uint32_t CHUNK_TILES = TILE_CHUNK_SIZE * TILE_CHUNK_SIZE;
+	const uint32_t FLOATS_PER_QUAD = 4 * 4;
+}
+
+TileMap::TileMap(uint32_t width, uint32_t height, uint32_t layerCount, float tileSize)
+	: mapWidth(width), mapHeight(height), layers(layerCount), size(tileSize),
+	  chunksX((width + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE), chunksY((height + TILE_CHUNK_SIZE - 1) / TILE_CHUNK_SIZE),
+	  tiles((size_t)width * height * layerCount, EMPTY_TILE), chunks((size_t)chunksX * chunksY * layerCount, Chunk{ 0, 0, 0, false }),
+	  rebuilds(0), atlas(0), atlasColumns(1), atlasRows(1), texelU(0.0f), texelV(0.0f), program(0), indexBuffer(0), projectionLocation(-1)
+{
+	vertices.reserve(CHUNK_TILES * FLOATS_PER_QUAD);
+}
+
+bool TileMap::init()
+{
+	program = buildProgram(VERTEX_SHADER, FRAGMENT_SHADER);
+	if (program == 0)
+	{
+		return false;
+	}
+	projectionLocation = glGetUniformLocation(program, "projection");
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "textureBuffer"), 0);
+
+	// Dois triângulos por quad, na ordem dos vértices do rebuild: 0 e 1 embaixo, 2 e 3 em cima
+	TaggedVector<uint16_t, MemoryTag::Tiles> indices(CHUNK_TILES * 6);
+	for (uint32_t quad = 0; quad < CHUNK_TILES; quad++)
+	{
+		uint16_t first = (uint16_t)(quad * 4);
+		uint16_t *index = &indices[quad * 6];
+		index[0] = first;
+		index[1] = first + 1;
+		index[2] = first + 2;
+		index[3] = first + 2;
+		index[4] = first + 1;
+		index[5] = first + 3;
+	}
+	glGenBuffers(1, &indexBuffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	return true;
+}
+
+void TileMap::shutdown()
+{
+	if (program == 0)
+	{
+		return;
+	}
+	for (Chunk &chunk : chunks)
+	{
+		if (chunk.vao != 0)
+		{
+			glDeleteVertexArrays(1, &chunk.vao);
+			glDeleteBuffers(1, &chunk.vbo);
+		}
+		// Se o mapa for usado num contexto novo, os chunks com tiles voltam a ser enviados
+		chunk = Chunk{ 0, 0, 0, chunk.dirty || chunk.quadCount > 0 };
+	}
+	glDeleteBuffers(1, &indexBuffer);
+	glDeleteProgram(program);
+	program = 0;
+}
+
+void TileMap::setProjection(const float *matrix)
+{
+	glUseProgram(program);
+	glUniformMatrix4fv(projectionLocation, 1, GL_FALSE, matrix);
+}
+
+void TileMap::setAtlas(GLuint texture, uint32_t columns, uint32_t rows)
+{
+	atlas = texture;
+	atlasColumns = std::max(columns, 1u);
+	atlasRows = std::max(rows, 1u);
+
+	GLint textureWidth = 1, textureHeight = 1;
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &textureWidth);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &textureHeight);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	texelU = 0.5f / std::max(textureWidth, 1);
+	texelV = 0.5f / std::max(textureHeight, 1);
+
+	for (Chunk &chunk : chunks)
+	{
+		chunk.dirty = chunk.dirty || chunk.quadCount > 0;
+	}
+}
+
+void TileMap::setTile(uint32_t layer, uint32_t x, uint32_t y, uint16_t tile)
+{
+	if (layer >= layers || x >= mapWidth || y >= mapHeight)
+	{
+		return;
+	}
+	uint16_t &slot = tiles[((size_t)layer * mapHeight + y) * mapWidth + x];
+	if (slot != tile)
+	{
+		slot = tile;
+		chunkAt(layer, x / TILE_CHUNK_SIZE, y / TILE_CHUNK_SIZE).dirty = true;
+	}
+}
+
+uint16_t TileMap::tile(uint32_t layer, uint32_t x, uint32_t y) const
+{
+	if (layer >= layers || x >= mapWidth || y >= mapHeight)
+	{
+		return EMPTY_TILE;
+	}
+	return tiles[((size_t)layer * mapHeight + y) * mapWidth + x];
+}
+
+void TileMap::rebuildChunk(Chunk &chunk, uint32_t layer, uint32_t cx, uint32_t cy)
+{
+	const float cellU = 1.0f / atlasColumns, cellV = 1.0f / atlasRows;
+	const uint32_t cellCount = atlasColumns * atlasRows;
+	const uint32_t x0 = cx * TILE_CHUNK_SIZE, x1 = std::min(x0 + TILE_CHUNK_SIZE, mapWidth);
+	const uint32_t y0 = cy * TILE_CHUNK_SIZE, y1 = std::min(y0 + TILE_CHUNK_SIZE, mapHeight);
+
+	vertices.clear();
+	for (uint32_t y = y0; y < y1; y++)
+	{
+		const uint16_t *row = &tiles[((size_t)layer * mapHeight + y) * mapWidth];
+		for (uint32_t x = x0; x < x1; x++)
+		{
+			if (row[x] == EMPTY_TILE || row[x] > cellCount)
+			{
+				continue;
+			}
+			// Célula no atlas; v = 0 é a primeira linha da imagem, que fica em cima do tile
+			uint32_t cell = row[x] - 1u;
+			float u0 = (cell % atlasColumns) * cellU + texelU, u1 = (cell % atlasColumns + 1) * cellU - texelU;
+			float vTop = (cell / atlasColumns) * cellV + texelV, vBottom = (cell / atlasColumns + 1) * cellV - texelV;
+			float left = x * size, right = (x + 1) * size, bottom = y * size, top = (y + 1) * size;
+			const float quad[FLOATS_PER_QUAD] = {
+				left, bottom, u0, vBottom,
+				right, bottom, u1, vBottom,
+				left, top, u0, vTop,
+				right, top, u1, vTop };
+			vertices.insert(vertices.end(), quad, quad + FLOATS_PER_QUAD);
+		}
+	}
+
+	rebuilds++;
+	chunk.quadCount = (uint32_t)(vertices.size() / FLOATS_PER_QUAD);
+	chunk.dirty = false;
+	if (chunk.quadCount == 0 && chunk.vao == 0)
+	{
+		return; // chunk vazio que nunca teve tiles: nada para criar na GPU
+	}
+
+	if (chunk.vao == 0)
+	{
+		glGenVertexArrays(1, &chunk.vao);
+		glGenBuffers(1, &chunk.vbo);
+		glBindVertexArray(chunk.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid *)0);
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid *)(2 * sizeof(GLfloat)));
+		glEnableVertexAttribArray(1);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer); // guardado no VAO
+	}
+	else
+	{
+		glBindVertexArray(chunk.vao);
+		glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+	}
+	// Estático: o chunk só é reenviado quando um tile dele muda
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+uint32_t TileMap::draw(float minX, float minY, float maxX, float maxY)
+{
+	// Chunks que cruzam a área visível, presos aos limites do mapa
+	const float chunkSize = size * TILE_CHUNK_SIZE;
+	if (maxX < 0.0f || maxY < 0.0f || minX >= chunksX * chunkSize || minY >= chunksY * chunkSize)
+	{
+		return 0;
+	}
+	uint32_t cx0 = (uint32_t)std::max(0.0f, std::floor(minX / chunkSize));
+	uint32_t cy0 = (uint32_t)std::max(0.0f, std::floor(minY / chunkSize));
+	uint32_t cx1 = std::min((uint32_t)(maxX / chunkSize), chunksX - 1);
+	uint32_t cy1 = std::min((uint32_t)(maxY / chunkSize), chunksY - 1);
+
+	glUseProgram(program);
+	glBindTexture(GL_TEXTURE_2D, atlas);
+	uint32_t draws = 0;
+	for (uint32_t layer = 0; layer < layers; layer++)
+	{
+		for (uint32_t cy = cy0; cy <= cy1; cy++)
+		{
+			for (uint32_t cx = cx0; cx <= cx1; cx++)
+			{
+				Chunk &chunk = chunkAt(layer, cx, cy);
+				if (chunk.dirty)
+				{
+					rebuildChunk(chunk, layer, cx, cy);
+				}
+				if (chunk.quadCount == 0)
+				{
+					continue;
+				}
+				glBindVertexArray(chunk.vao);
+				glDrawElements(GL_TRIANGLES, chunk.quadCount * 6, GL_UNSIGNED_SHORT, 0);
+				draws++;
+			}
+		}
+	}
+	glBindVertexArray(0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	return draws;
+}
@@ -1,2 +1,9 @@
 #define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
\ No newline at end of file
+// Com TRACK_IMAGE_MEMORY, os buffers decodificados entram na tag Images do MemoryTracker (Common)
+#ifdef TRACK_IMAGE_MEMORY
+#include "MemoryTracker.h"
+#define STBI_MALLOC(size) memoryAlloc(MemoryTag::Images, size)
+#define STBI_REALLOC(pointer, size) memoryRealloc(MemoryTag::Images, pointer, size)
+#define STBI_FREE(pointer) memoryFree(pointer)
+#endif
+#include "stb_image.h"
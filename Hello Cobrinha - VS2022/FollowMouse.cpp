@@ -28,6 +28,8 @@
 #include <cmath>
 #include <vector>
 
+#include "FastMath.h" // Trigonometria e raiz inversa aproximadas para o laço principal
+
 using namespace std;
 using namespace glm;
 
@@ -112,16 +114,20 @@ int main() {
         double xPos, yPos;
         glfwGetCursorPos(window, &xPos, &yPos);
         mousePos = vec2(xPos, height - yPos);  // Inverte o eixo Y para se alinhar à tela
-        vec3 dir = normalize(vec3(mousePos, 0.0) - triangle.position);
-        float angle = atan2(dir.y, dir.x);
+        // Uma raiz inversa aproximada dá a direção e a distância (erro relativo < 0.07%, invisível aqui)
+        vec3 toMouse = vec3(mousePos, 0.0) - triangle.position;
+        float lengthSquared = toMouse.x * toMouse.x + toMouse.y * toMouse.y;
+        float invLength = fastRsqrt(lengthSquared);
+        vec3 dir = toMouse * invLength;
+        float angle = fastAtan2(toMouse.y, toMouse.x);
 
         // Move o triângulo suavemente na direção do mouse
-        if (distance(triangle.position, vec3(mousePos, 0.0)) > 0.01f) {
+        if (lengthSquared * invLength > 0.01f) {
             triangle.position += 0.5f * dir;  // Aumente ou diminua 0.5f para controlar a velocidade
         }
 
         // Atualiza o ângulo de rotação do triângulo
-        triangle.angle = angle + radians(-90.0f); // Rotaciona para que a ponta aponte para o mouse
+        triangle.angle = angle - 0.5f * FAST_PI; // Rotaciona para que a ponta aponte para o mouse
 
         // Desenha o triângulo e o cursor
         drawGeometry(shaderID, triangle.VAO, triangle.nVertices, triangle.position, triangle.dimensions, triangle.angle, triangle.color);
@@ -17,6 +17,9 @@
 //CMath - do próprio C++
 #include<cmath>
 
+// Geração de geometria com tabela de seno/cosseno (Common)
+#include "Geometry.h"
+
 using namespace std;
 
 // GLAD
@@ -37,6 +40,7 @@ int setupGeometry();
 int createCircle(int nPoints, float radius = 0.5);
 int createSpiral(int &nPoints);
 int createStar(int nPoints, float minRadius, float maxRadius);
+int uploadMesh(const Mesh& mesh);
 
 // Dimensões da janela (pode ser alterado em tempo de execução)
 const GLuint WIDTH = 800, HEIGHT = 600;
@@ -278,188 +282,63 @@ int setupGeometry()
 	return VAO;
 }
 
+// Os vértices vêm do módulo Geometry (tabela de seno/cosseno, tamanho exato, sem push_back);
+// aqui só enviamos a malha indexada para a OpenGL. O vértice 0 é o centro e a borda ocupa
+// os vértices 1 a nPoints, então glDrawArrays(GL_LINE_LOOP, 1, nPoints) desenha o contorno e
+// glDrawElements(GL_TRIANGLES, 3 * nPoints, GL_UNSIGNED_INT, 0) desenha o polígono preenchido
 int createCircle(int nPoints, float radius)
 {
-	vector <GLfloat> vertices;
-
-	float angle = 0.0;
-	float slice = 2 * Pi / (float)nPoints;
-
-	//Adicionar o ponto da origem (0.0,0.0,0.0) como sendo o centro do círculo
-	vertices.push_back(0.0); // Xc
-	vertices.push_back(0.0); // Yc
-	vertices.push_back(0.0); // Zc
-
-	for (int i = 0; i < nPoints+1; i++)
-	{
-		float x = radius * cos(angle);
-		float y = radius * sin(angle);
-		float z = 0.0;
-
-		vertices.push_back(x); // x
-		vertices.push_back(y); // y
-		vertices.push_back(z); // z
-
-		angle = angle + slice;
-	}
-
-	//Configuração dos buffer VBO e VAO
-	GLuint VBO, VAO;
-	//Geração do identificador do VBO
-	glGenBuffers(1, &VBO);
-	//Faz a conexão (vincula) do buffer como um buffer de array
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	//Envia os dados do array de floats para o buffer da OpenGl
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-	//Geração do identificador do VAO (Vertex Array Object)
-	glGenVertexArrays(1, &VAO);
-	// Vincula (bind) o VAO primeiro, e em seguida  conecta e seta o(s) buffer(s) de vértices
-	// e os ponteiros para os atributos 
-	glBindVertexArray(VAO);
-	//Para cada atributo do vertice, criamos um "AttribPointer" (ponteiro para o atributo), indicando: 
-	// Localização no shader * (a localização dos atributos devem ser correspondentes no layout especificado no vertex shader)
-	// Numero de valores que o atributo tem (por ex, 3 coordenadas xyz) 
-	// Tipo do dado
-	// Se está normalizado (entre zero e um)
-	// Tamanho em bytes 
-	// Deslocamento a partir do byte zero 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-	glEnableVertexAttribArray(0);
-
-	// Observe que isso é permitido, a chamada para glVertexAttribPointer registrou o VBO como o objeto de buffer de vértice 
-	// atualmente vinculado - para que depois possamos desvincular com segurança
-	glBindBuffer(GL_ARRAY_BUFFER, 0); 
-
-	// Desvincula o VAO (é uma boa prática desvincular qualquer buffer ou array para evitar bugs medonhos)
-	glBindVertexArray(0); 
-
-	return VAO;
-
+	Mesh mesh;
+	generateCircle(mesh, SinCosTable(nPoints), radius);
+	return uploadMesh(mesh);
 }
 
+// nPoints recebe o número de pontos da curva (vértices 1 a nPoints); os índices ligam cada
+// ponto ao seguinte, para glDrawElements(GL_LINES, 2 * (nPoints - 1), GL_UNSIGNED_INT, 0)
 int createSpiral(int &nPoints)
 {
-	vector <GLfloat> vertices;
-
-	float angle = 0.0;
-	float slice = 0.08;
-	float radius = 0.05;
-
-	//Adicionar o ponto da origem (0.0,0.0,0.0) como sendo o centro do círculo
-	vertices.push_back(0.0); // Xc
-	vertices.push_back(0.0); // Yc
-	vertices.push_back(0.0); // Zc
-
-	for (float angle = 0.0; angle < 12 * Pi; angle = angle + slice)
-	{
-		float x = radius * cos(angle);
-		float y = radius * sin(angle);
-		float z = 0.0;
-
-		vertices.push_back(x); // x
-		vertices.push_back(y); // y
-		vertices.push_back(z); // z
-		radius += 0.001;
-	}
-
-	nPoints = vertices.size();
-	//Configuração dos buffer VBO e VAO
-	GLuint VBO, VAO;
-	//Geração do identificador do VBO
-	glGenBuffers(1, &VBO);
-	//Faz a conexão (vincula) do buffer como um buffer de array
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	//Envia os dados do array de floats para o buffer da OpenGl
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-	//Geração do identificador do VAO (Vertex Array Object)
-	glGenVertexArrays(1, &VAO);
-	// Vincula (bind) o VAO primeiro, e em seguida  conecta e seta o(s) buffer(s) de vértices
-	// e os ponteiros para os atributos 
-	glBindVertexArray(VAO);
-	//Para cada atributo do vertice, criamos um "AttribPointer" (ponteiro para o atributo), indicando: 
-	// Localização no shader * (a localização dos atributos devem ser correspondentes no layout especificado no vertex shader)
-	// Numero de valores que o atributo tem (por ex, 3 coordenadas xyz) 
-	// Tipo do dado
-	// Se está normalizado (entre zero e um)
-	// Tamanho em bytes 
-	// Deslocamento a partir do byte zero 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
-	glEnableVertexAttribArray(0);
-
-	// Observe que isso é permitido, a chamada para glVertexAttribPointer registrou o VBO como o objeto de buffer de vértice 
-	// atualmente vinculado - para que depois possamos desvincular com segurança
-	glBindBuffer(GL_ARRAY_BUFFER, 0); 
-
-	// Desvincula o VAO (é uma boa prática desvincular qualquer buffer ou array para evitar bugs medonhos)
-	glBindVertexArray(0); 
-
-	return VAO;
-
+	Mesh mesh;
+	// 6 voltas, um ponto a cada 0.08 rad, raio começando em 0.05 e crescendo 0.001 por ponto
+	generateSpiral(mesh, 12 * Pi, 0.08, 0.05, 0.001);
+	nPoints = mesh.vertexCount() - 1;
+	return uploadMesh(mesh);
 }
 
 int createStar(int nPoints, float minRadius, float maxRadius)
 {
-	vector <GLfloat> vertices;
-
-	float angle = 0.0;
-	float slice = 2 * Pi / (float)nPoints;
-	float radius;
-
-	//Adicionar o ponto da origem (0.0,0.0,0.0) como sendo o centro do círculo
-	vertices.push_back(0.0); // Xc
-	vertices.push_back(0.0); // Yc
-	vertices.push_back(0.0); // Zc
-
-	for (int i = 0; i < nPoints+1; i++)
-	{
-		if (i % 2 == 0) radius = maxRadius;
-		else radius = minRadius;
-
-		float x = radius * cos(angle);
-		float y = radius * sin(angle);
-		float z = 0.0;
-
-		vertices.push_back(x); // x
-		vertices.push_back(y); // y
-		vertices.push_back(z); // z
+	Mesh mesh;
+	generateStar(mesh, SinCosTable(nPoints), minRadius, maxRadius);
+	return uploadMesh(mesh);
+}
 
-		angle = angle + slice;
-	}
+// Cria o VAO com um VBO (posições) e um EBO (índices) a partir da malha
+int uploadMesh(const Mesh& mesh)
+{
+	GLuint VBO, EBO, VAO;
+	//Geração do identificador do VAO (Vertex Array Object)
+	glGenVertexArrays(1, &VAO);
+	// Vincula (bind) o VAO primeiro: o EBO vinculado em seguida fica registrado nele
+	glBindVertexArray(VAO);
 
-	//Configuração dos buffer VBO e VAO
-	GLuint VBO, VAO;
-	//Geração do identificador do VBO
+	//Envia as coordenadas x, y, z dos vértices para o VBO
 	glGenBuffers(1, &VBO);
-	//Faz a conexão (vincula) do buffer como um buffer de array
 	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	//Envia os dados do array de floats para o buffer da OpenGl
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
+	glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(GLfloat), mesh.vertices.data(), GL_STATIC_DRAW);
 
-	//Geração do identificador do VAO (Vertex Array Object)
-	glGenVertexArrays(1, &VAO);
-	// Vincula (bind) o VAO primeiro, e em seguida  conecta e seta o(s) buffer(s) de vértices
-	// e os ponteiros para os atributos 
-	glBindVertexArray(VAO);
-	//Para cada atributo do vertice, criamos um "AttribPointer" (ponteiro para o atributo), indicando: 
-	// Localização no shader * (a localização dos atributos devem ser correspondentes no layout especificado no vertex shader)
-	// Numero de valores que o atributo tem (por ex, 3 coordenadas xyz) 
-	// Tipo do dado
-	// Se está normalizado (entre zero e um)
-	// Tamanho em bytes 
-	// Deslocamento a partir do byte zero 
+	//Envia os índices para o EBO (Element Buffer Object)
+	glGenBuffers(1, &EBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(GLuint), mesh.indices.data(), GL_STATIC_DRAW);
+
+	// Atributo 0: posição, 3 floats por vértice
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
 	glEnableVertexAttribArray(0);
 
-	// Observe que isso é permitido, a chamada para glVertexAttribPointer registrou o VBO como o objeto de buffer de vértice 
-	// atualmente vinculado - para que depois possamos desvincular com segurança
-	glBindBuffer(GL_ARRAY_BUFFER, 0); 
-
-	// Desvincula o VAO (é uma boa prática desvincular qualquer buffer ou array para evitar bugs medonhos)
-	glBindVertexArray(0); 
+	// Desvincula o VBO (o VAO já guardou o ponteiro do atributo) e depois o VAO;
+	// o EBO só é desvinculado depois do VAO, senão o VAO perderia a referência
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glBindVertexArray(0);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 	return VAO;
-
 }
-
@@ -15,6 +15,29 @@
 #include <glm/glm.hpp>	
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "GlmConfig.h"
+#include "SpriteStore.h"
+#include "SpatialGrid.h"
+#include "SweptAABB.h"
+#include "JobSystem.h"
+#include "TripleBuffer.h"
+#include "InputQueue.h"
+#include "SpriteRenderer.h"
+#include "ParallaxBackground.h"
+#include "Logger.h"
+#include "FramePacer.h"
+#include "ScriptScheduler.h"
+#include "Profiler.h"
+#include "GpuProfiler.h"
+#include "RenderStats.h"
+#include "DebugHud.h"
+#include "MemoryTracker.h"
+#include "Telemetry.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
 using namespace std;
 using namespace glm;
 
@@ -23,20 +46,33 @@ const GLuint WIDTH = 800, HEIGHT = 600;
 const float velMax = 0.5f, velMin = 0.1f;
 const float FPS = 12.0f;
 const int numlives = 3;
-const int maxItems = 4;
+const int maxItems = 32; // capacidade: a chuva contnua mais as ondas dos scripts
+const uint32_t rainItems = 4; // itens sempre caindo, como no jogo original
+const float gridCellSize = 64.0f;
+const uint32_t jobGrain = 1024; // itens por job nos sistemas paralelos
+const int simTicksPerSecond = 60; // a simulao avana em ticks fixos, independente do present
+const uint32_t maxInstances = maxItems + 1; // personagem + itens (o fundo  do ParallaxBackground)
 const int spriteSheetColuns = 6, spriteSheetLines = 3;
+// Fundo em parallax: faixas de parallax.png (background.png reduzido pelo Benchmarks/ParallaxLayers), de trs para frente
+const float backgroundRows[] = { 0, 216, 999, 1236, 1296 }; // cu, floresta, gelo e cho, em linhas do original
+const float backgroundScale = HEIGHT / 1296.0f; // o original ocupa a altura da janela
+const float backgroundRates[] = { 0.05f, 0.2f, 0.5f, 0.8f }; // frao do deslocamento do personagem
+const float backgroundDrifts[] = { 6.0f, 0.0f, 0.0f, 0.0f }; // pixels por segundo: a neve do cu anda sozinha
 
 
 enum sprites_states { IDLE = 1, MOVING_RIGHT, MOVING_LEFT };
 enum sprites_effect { NONE, COLLECT, DENY };
+enum item_types { FRUIT, ICECUBE, NUM_ITEM_TYPES };
+// Camadas de desenho, na ordem em que so desenhadas; cada camada usa uma textura e vira um draw instanciado
+enum render_layers { LAYER_CHARACTER, LAYER_ITEMS, NUM_LAYERS = LAYER_ITEMS + NUM_ITEM_TYPES };
 
 //Estrutura de dados das Sprites
 struct Sprite {
 
-	GLfloat VAO;
 	GLfloat textureID;
-	vec3 pos;
-	vec3 dimensions;
+	int layer;
+	math_vec4 pos; // w = 1; alinhado e em SSE com GLM_SIMD_MATH (GlmConfig.h)
+	math_vec4 dimensions;
 	float angle;
 
 	int nAnimations;
@@ -47,26 +83,50 @@ struct Sprite {
 
 	float vel;
 
-	vec2 PMax, PMin;
+	math_vec4 PMax, PMin; // s x e y so usados
 	int effect;
 };
 
+// Snapshot de um tick, publicado pela simulao e s lido pela thread de OpenGL
+struct FrameSnapshot {
+	InstanceSprite sprites[maxInstances];
+	uint32_t count = 0;
+	GLuint layerTextures[NUM_LAYERS] = {};
+	bool gameover = false;
+	int64_t inputTime = 0; // instante do evento de entrada mais antigo aplicado neste tick (0 se nenhum)
+	float simMs = 0.0f; // trabalho do tick que gerou o snapshot, para a telemetria
+	uint32_t entities = 0; // itens vivos e o personagem
+	float scroll = 0.0f; // personagem em relao ao centro da tela: o fundo em parallax acompanha
+};
+
 // Prottipo da funo de callback de teclado
-void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);
+void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode);/*Esc fecha a janela, P troca o modo de frame pacing, F3 mostra as estatsticas de renderizao e de memria, F4 imprime o uso de memria por subsistema, F5 liga e desliga a gravao da telemetria e F9 grava o trace do profiler; as demais teclas vo para a simulao.*/
 
 // Prottipos (ou Cabealhos) das funes
-int setupShader();
 int loadTexture(string filePath, int& width, int& height);
 
-void drawSprite(GLuint shaderID, Sprite& sprite);
-void updateSprite(GLuint shaderID, Sprite& sprite);
-void moveSprite(GLuint shaderID, Sprite& sprite); /*Implementa a movimentao do personagem principal com as teclas de seta ou "A" e "D" (movimento horizontal). Cada tecla ajusta a posio e o estado de animao do personagem.*/
-
-void updateItems(GLuint shader, Sprite& sprite);
-void spawnItem(Sprite& sprite);/*Responsvel por definir a posio inicial e a velocidade aleatria dos itens que caem. Os itens so reposicionados aleatoriamente no eixo X e sua velocidade  ajustada aleatoriamente.*/
+void simulationLoop(Sprite character);/*Thread da simulao: consome a entrada, roda a lgica em ticks fixos e publica um FrameSnapshot por tick.*/
+void addInstance(FrameSnapshot& frame, const Sprite& sprite, math_vec4 pos);
+void drawFrame(JobSystem& jobs, const FrameSnapshot& frame);/*Desenha o fundo em parallax num passe s e depois o snapshot com o SpriteRenderer: as instncias so geradas nos workers, direto no buffer mapeado, e cada camada vira um draw instanciado.*/
+void animateSprite(Sprite& sprite);
+void moveSprite(Sprite& sprite); /*Implementa a movimentao do personagem principal com as teclas de seta ou "A" e "D" (movimento horizontal). O deslocamento  proporcional  frao do tick em que cada tecla ficou pressionada.*/
+
+void kickItemSystems(JobSystem& jobs);/*Agenda nos workers o passo dos itens: movimento, AABBs e grade, nessa ordem. O resultado fica pronto quando itemGridReady zerar.*/
+void moveItemsJob(void* data, uint32_t first, uint32_t last);
+void buildItemAABBsJob(void* data, uint32_t first, uint32_t last);
+void buildItemGridJob(void* data, uint32_t first, uint32_t last);
+EntityHandle createItem(int prototype);/*Retira um item do SpriteStore, sem alocao nem cpia do prottipo.*/
+void destroyItem(EntityHandle handle);/*Devolve o item ao SpriteStore; o ltimo item vivo ocupa o lugar dele nas colunas.*/
+void placeItem(EntityHandle handle, float x, float vel);/*Coloca um item recm-criado no topo da tela, na posio X e com a velocidade de queda escolhidas por um script.*/
+int randomInt(int min, int max);/*Sorteia um inteiro em [min, max] com o gerador da simulao.*/
+void spawnItem(uint32_t i);/*Responsvel por definir a posio inicial e a velocidade aleatria dos itens que caem. Os itens so reposicionados aleatoriamente no eixo X e sua velocidade  ajustada aleatoriamente.*/
+
+Script rainScript(uint32_t count);/*Chuva contnua: repe os itens da prpria chuva que saram da tela ou foram pegos at haver count deles caindo, sem contar os das ondas e do bnus, com posio e velocidade sorteadas por spawnItem.*/
+Script waveScript(const Sprite* character);/*A cada 15 s, uma fileira de frutas atravessa a tela da esquerda para a direita e, em seguida, cubos de gelo caem mirando o personagem. Cada onda tem um cubo a mais, at 5.*/
+Script bonusScript();/*A cada 5 frutas coletadas, cai uma rajada de frutas mais lentas espalhadas pela tela.*/
 
 void calculateAABB(Sprite& sprite);
-bool checkCollision(Sprite one, Sprite two);
+uint32_t checkCollisions(const Sprite& one, const SpriteStore& store, uint32_t* hits, float* hitTimes);/*Busca os itens candidatos na grade j construda (broadphase) e testa o movimento deles no tick contra o sprite (swept AABB). Devolve os ndices atingidos em ordem crescente e o instante de cada contato.*/
 
 Sprite initializeSprite(GLuint textureID,
 	vec3 dimensions,
@@ -78,22 +138,37 @@ Sprite initializeSprite(GLuint textureID,
 	float angle = 0.0);
 
 // Variveis globais
-bool keys[1024];
+KeyboardState keyboard; // estado das teclas, s acessado pela simulao
+std::mt19937 simRandom; // sorteios dos spawns, s acessado pela simulao; semeado no incio da thread
 float velCharacter = velMin;
 float velItems = velMin;
 float lastSpawnX = 400.0;
 float lastTime = 0;
 int lives = numlives;
 int itemsTextureID[4];
+Sprite itemPrototypes[NUM_ITEM_TYPES];
+SpriteStore itemStore(maxItems); // colunas densas: os itens vivos ocupam [0, itemStore.size())
+SpatialGrid itemGrid(gridCellSize, 0.0f, 0.0f, WIDTH, HEIGHT); // reconstruda a cada frame
+JobCounter itemsMoved, itemsBounded, itemGridReady; // etapas do passo dos itens
+TripleBuffer<FrameSnapshot> snapshots; // simulao -> OpenGL
+ScriptEvent fruitCollected; // sinalizado pela simulao a cada fruta pega
+InputQueue inputQueue; // key_callback -> simulao, com o instante de cada evento
+LatencySampler inputLatency; // entrada -> present, medida na thread de OpenGL
+std::atomic<bool> simRunning(true);
+ParallaxBackground parallaxBackground; // camadas pequenas que repetem em x, num draw antes dos sprites
+SpriteRenderer spriteRenderer(NUM_LAYERS, maxInstances); // quad compartilhado + dados por instncia; sem rotao (nenhum sprite do jogo gira)
+Logger gameLog; // formata e escreve numa thread de fundo, sem flush no loop do jogo
+const uint16_t LOG_GAMEPLAY = gameLog.addCategory("gameplay", 20); // no mximo 20 mensagens/s
+const uint16_t LOG_FRAME = gameLog.addCategory("frame");
+const uint16_t LOG_RESULT = gameLog.addCategory("resultado"); // sem limite: o fim da partida nunca pode ser descartado
+FramePacer framePacer; // ritmo da thread de OpenGL; P troca o modo
+DebugHud hud; // estatsticas de renderizao na tela
+bool showHud = false; // F3 liga e desliga o HUD
+Telemetry telemetry; // F5 grava os frames e eventos em telemetry.bin (Benchmarks/TelemetryToCsv converte)
 
 
 int main() {
 
-	srand(time(0));
-
-	for (int i = 0; i < 1024; i++) { keys[i] = false; }
-
-
 	// Inicializao da GLFW
 	glfwInit();
 
@@ -120,6 +195,12 @@ int main() {
 
 	// GLAD: carrega todos os ponteiros d funes da OpenGL
 	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) { cout << "Failed to initialize GLAD" << std::endl; }/*Inicializa a API OpenGL utilizando a biblioteca GLAD, garantindo compatibilidade com OpenGL 3.3 ou superior.*/
+	installRenderStats(); // a partir daqui as chamadas de OpenGL passam pelos contadores
+	installGpuMemoryTracking(); // e buffers/texturas criados entram na estimativa de memria da GPU
+	// Oramentos de memria: o HUD e o dump (F4) marcam quem passar
+	setMemoryBudget(MemoryTag::Sprites, 1 << 20);
+	setMemoryBudget(MemoryTag::Images, 16 << 20);
+	setGpuMemoryBudget(GpuMemoryKind::Textures, 64 << 20);
 
 	// Obtendo as informaes de verso
 	const GLubyte* renderer = glGetString(GL_RENDERER);
@@ -132,49 +213,49 @@ int main() {
 	glfwGetFramebufferSize(window, &width, &height);
 	glViewport(0, 0, width, height);
 
-	// Compilando e buildando o programa de shader
-	GLuint shaderID = setupShader();
-	glUseProgram(shaderID);
+	// Frame pacing: o alvo  a taxa de atualizao do monitor
+	const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+	framePacer.setMode(PACING_VSYNC, videoMode ? videoMode->refreshRate : 60.0);
+	glfwSwapInterval(framePacer.swapInterval());
+
+	// Compilando e buildando o programa de shader, o quad dos sprites e o buffer de instncias
+	if (!spriteRenderer.init()) { cout << "Failed to initialize the sprite renderer" << std::endl; }
+	if (!parallaxBackground.init()) { cout << "Failed to initialize the parallax background" << std::endl; }
 
 	//Criao dos sprites - objetos da cena
-	Sprite background, character, fruit, icecube;
-	vector <Sprite> items;
+	Sprite character;
 
 
-	int score = 0;
-	bool gameover = false;
 	int imgWidth, imgHeight, textureID;
 
-	// Carregando uma textura do personagem e armazenando seu id
-	textureID = loadTexture("../Textures/Backgrounds/background.png", imgWidth, imgHeight);
-	background = initializeSprite(textureID, vec3(imgWidth * 0.4, imgHeight * 0.4, 1.0), vec3(400, 300, 0));
+	// Carregando a folha do fundo; cada faixa de linhas vira uma camada na sua faixa da tela
+	textureID = loadTexture("../Textures/Backgrounds/parallax.png", imgWidth, imgHeight);
+	parallaxBackground.setSheet(textureID);
+	for (uint32_t i = 0; i < MAX_PARALLAX_LAYERS; i++) {
+		parallaxBackground.addLayer(backgroundRows[i] / 1296.0f, backgroundRows[i + 1] / 1296.0f, HEIGHT - backgroundRows[i + 1] * backgroundScale, HEIGHT - backgroundRows[i] * backgroundScale, backgroundRates[i], backgroundDrifts[i]);
+	}
 
+	// Carregando uma textura do personagem e armazenando seu id
 	textureID = loadTexture("../Textures/Characters/character.png", imgWidth, imgHeight);
 	character = initializeSprite(textureID, vec3(imgWidth * 3.0, imgHeight * 3.0, 1.0), vec3(400, 100, 0), NONE, spriteSheetLines, spriteSheetColuns, velCharacter);
+	character.layer = LAYER_CHARACTER;
 
 	textureID = loadTexture("../Textures/Items/fruit.png", imgWidth, imgHeight);
-	fruit = initializeSprite(textureID, vec3(imgWidth * 0.1, imgHeight * 0.1, 1.0), vec3(0, 0, 0), COLLECT);
+	itemPrototypes[FRUIT] = initializeSprite(textureID, vec3(imgWidth * 0.1, imgHeight * 0.1, 1.0), vec3(0, 0, 0), COLLECT);
+	itemPrototypes[FRUIT].layer = LAYER_ITEMS + (int)FRUIT;
 
 	textureID = loadTexture("../Textures/Items/icecube.png", imgWidth, imgHeight);
-	icecube = initializeSprite(textureID, vec3(imgWidth * 1.5, imgHeight * 1.5, 1.0), vec3(0, 0, 0), DENY);
+	itemPrototypes[ICECUBE] = initializeSprite(textureID, vec3(imgWidth * 1.5, imgHeight * 1.5, 1.0), vec3(0, 0, 0), DENY);
+	itemPrototypes[ICECUBE].layer = LAYER_ITEMS + (int)ICECUBE;
 
 
-	for (int i = 0; i < maxItems; i++) {
-		int n = rand() % 2;
-		if (n == 1) { items.push_back(fruit); }
-		else { items.push_back(icecube); }
-		spawnItem(items[i]);
-	}
-
 	//Ativando o primeiro buffer de textura da OpenGL
 	glActiveTexture(GL_TEXTURE0);
 
-	// Enviar a informao de qual varivel armazenar o buffer da textura
-	glUniform1i(glGetUniformLocation(shaderID, "textureBuffer"), 0);
-
 	// Matriz de projeo paralela ortogrfica
 	mat4 projection = ortho(0.0, 800.0, 0.0, 600.0, -1.0, 1.0);/*Configura a matriz de projeo ortogrfica 2D para mapear o espao da tela e os objetos do jogo.*/
-	glUniformMatrix4fv(glGetUniformLocation(shaderID, "projection"), 1, GL_FALSE, value_ptr(projection));
+	spriteRenderer.setProjection(value_ptr(projection));
+	parallaxBackground.setProjection(value_ptr(projection));
 
 	//Habilitando o teste de profundidade
 	glEnable(GL_DEPTH_TEST);
@@ -186,70 +267,116 @@ int main() {
 
 	character.iAnimation = IDLE; // = 1
 
-	cout << "Score: " << score << endl;/*Exibe a pontuao atual do jogador no terminal aps coletar um item.*/
-	cout << "Vidas: " << lives << endl;/*Atualiza o nmero de vidas do jogador ao colidir com itens prejudiciais. Quando as vidas chegam a 0, o jogo termina.*/
+	// A simulao roda na sua prpria thread; esta thread s consome snapshots e desenha
+	std::thread simulation(simulationLoop, character);
+
+	// Workers que escrevem as instncias no buffer mapeado (a simulao tem os seus)
+	JobSystem renderJobs(std::max(2u, std::thread::hardware_concurrency() / 2));
 
-	// Loop da aplicao - "game loop"
+	PROFILE_THREAD("OpenGL");
+	PROFILE_GPU_INIT();
+	hud.init();
+
+	// Loop da aplicao - "game loop" (lado do OpenGL)
+	bool gameover = false;
+	chrono::steady_clock::time_point lastPresent = chrono::steady_clock::now();
 	while (!glfwWindowShouldClose(window) && !gameover) {
 
+		// No modo de baixa latncia, espera aqui para ler a entrada o mais perto possvel do vblank
+		{
+			PROFILE_ZONE("pacing");
+			framePacer.beginFrame();
+		}
+		chrono::steady_clock::time_point workStart = chrono::steady_clock::now();
+		beginRenderStats();
+
 		// Checa se houveram eventos de input (key pressed, mouse moved etc.) e chama as funes de callback correspondentes
-		glfwPollEvents();
-
-		// Limpa o buffer de cor
-		glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		glUniform2f(glGetUniformLocation(shaderID, "offsetTexture"), 0.0, 0.0);
-
-		 // Atualiza as hitboxes e verifica colises
-        calculateAABB(character);
-        for (int i = 0; i < items.size(); i++) {
-            calculateAABB(items[i]);
-            if (checkCollision(character, items[i])) {
-                // Atualiza pontuao ou vidas com base no tipo de item
-                if (items[i].effect == COLLECT) {
-                    score++;
-                    cout << "Score: " << score << endl;
-                } else if (items[i].effect == DENY) {
-                    lives--;
-                    cout << "Vidas: " << lives << endl;
-                }
-
-                // Reposiciona o item aps a coliso
-                int n = rand() % 2;
-                if (n == 1) { items[i] = fruit; }
-                else { items[i] = icecube; }
-                spawnItem(items[i]);
-            }
-        }
-
-		// Renderiza os sprites na tela
-		drawSprite(shaderID, background);
-		moveSprite(shaderID, character);
-		updateSprite(shaderID, character);
-		drawSprite(shaderID, character);
-
-		glUniform2f(glGetUniformLocation(shaderID, "offsetTexture"), 0.0, 0.0);
-
-		// Atualiza e desenha itens
-		for (int i = 0; i < items.size(); i++) {
-			drawSprite(shaderID, items[i]);
-			updateItems(shaderID, items[i]);
+		{
+			PROFILE_ZONE("poll");
+			glfwPollEvents();
 		}
 
-		if (lives <= 0) {
-			gameover = true;
-			cout << "GAME OVER!" << endl;/*Implementa a lgica de "Game Over" quando as vidas do jogador chegam a zero.*/
+		// Pega o snapshot mais recente; se a simulao no publicou nada novo, redesenha o anterior
+		bool fresh = snapshots.acquire();
+		const FrameSnapshot& frame = snapshots.readBuffer();
+
+		PROFILE_GPU_BEGIN_FRAME();
+		{
+			PROFILE_ZONE("draw");
+			PROFILE_GPU_ZONE("draw");
+
+			// Limpa o buffer de cor
+			glClearColor(193 / 255.0f, 229 / 255.0f, 245 / 255.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// Renderiza os sprites na tela
+			drawFrame(renderJobs, frame);
+			gameover = frame.gameover;
+
+			// O HUD mostra o frame anterior (o atual ainda no fechou) e no entra na contagem
+			if (showHud) {
+				char text[1536];
+				int length = formatRenderStats(lastRenderStats(), text, sizeof(text));
+				length += snprintf(text + length, sizeof(text) - length, "\npacing %s\n\n", FramePacer::modeName(framePacer.mode()));
+				formatMemoryStats(text + length, sizeof(text) - length);
+				pauseRenderStats(true);
+				hud.print(12.0f, 12.0f, text);
+				hud.draw(width, height);
+				pauseRenderStats(false);
+			}
 		}
+		PROFILE_GPU_END_FRAME();
 
-		glBindVertexArray(0);
+		double cpuMs = chrono::duration<double, milli>(chrono::steady_clock::now() - workStart).count();
+		framePacer.beforeSwap();
+		{
+			PROFILE_ZONE("swap");
+			glfwSwapBuffers(window);
+		}
+		chrono::steady_clock::time_point present = chrono::steady_clock::now();
+		const RenderStats& stats = endRenderStats(chrono::duration<double, milli>(present - lastPresent).count(), cpuMs, gpuProfiler.lastFrameMs());
+		if (telemetry.recording()) {
+			TelemetryRecord record = {};
+			record.frameMs = (float)stats.frameMs;
+			record.simMs = frame.simMs;
+			record.renderMs = (float)stats.cpuMs;
+			record.gpuMs = (float)stats.gpuMs;
+			record.drawCalls = stats.drawCalls;
+			record.instances = (uint32_t)stats.instances;
+			record.entities = frame.entities;
+			telemetry.recordFrame(record);
+		}
+		lastPresent = present;
+		// Latncia da entrada: do evento at o primeiro present do tick que o aplicou
+		if (fresh && frame.inputTime != 0) {
+			inputLatency.add((inputClockNs() - frame.inputTime) / 1e6);
+		}
+		{
+			PROFILE_ZONE("pacing");
+			framePacer.endFrame();
+		}
 
-		glfwSwapBuffers(window);
+		// Relatrio do tempo de frame a cada janela de estatsticas
+		if (framePacer.frameCount() % FramePacer::HISTORY == 0) {
+			FrameStats stats = framePacer.stats();
+			gameLog.log(LOG_INFO, LOG_FRAME, "{}: p50 {} ms, p99 {} ms, desvio {} ms", FramePacer::modeName(framePacer.mode()), stats.p50, stats.p99, stats.stddev);
+			gameLog.log(LOG_INFO, LOG_FRAME, "trabalho {} ms, sleep {} ms, spin {} ms por frame", stats.workMean, stats.sleepMean, stats.spinMean);
+			if (inputLatency.sampleCount() > 0) {
+				gameLog.log(LOG_INFO, LOG_FRAME, "entrada -> present: p50 {} ms, p99 {} ms", inputLatency.percentile(0.5), inputLatency.percentile(0.99));
+			}
+		}
 	}
 
+	simRunning.store(false);
+	simulation.join();
+
 	if (!glfwWindowShouldClose(window)) { glfwSetWindowShouldClose(window, GL_TRUE); }
 	// Pede pra OpenGL desalocar os buffers
-	//glDeleteVertexArrays(1, character.VAO);
+	telemetry.stop();
+	spriteRenderer.shutdown();
+	parallaxBackground.shutdown();
+	PROFILE_GPU_SHUTDOWN();
+	hud.shutdown();
 	// Finaliza a execuo da GLFW, limpando os recursos alocados por ela
 	glfwTerminate();
 	return 0;
@@ -258,86 +385,170 @@ int main() {
 void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode) {
 
 	if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) { glfwSetWindowShouldClose(window, GL_TRUE); }
-	if (action == GLFW_PRESS) { keys[key] = true; }
-	else if (action == GLFW_RELEASE) { keys[key] = false; }
-}
-
-//  A funo retorna o identificador do programa de shader
-int setupShader() {
-	// Cdigo do shader de vrtices (Vertex Shader)
-	const GLchar* vertexShaderSource = R"(
-		#version 400
-		layout (location = 0) in vec3 coordenadasDaGeometria;
-		layout (location = 1) in vec2 coordenadasDaTextura;
-		uniform mat4 projection;
-		uniform mat4 model;
-		out vec2 textureCoord;
-		void main() {
-   			gl_Position = projection * model * vec4( coordenadasDaGeometria , 1.0 );
-			textureCoord = vec2( coordenadasDaTextura.s , 1.0 - coordenadasDaTextura.t );
+	// Troca o modo de frame pacing (o callback roda na thread de OpenGL, com o contexto ativo)
+	if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+		PacingMode next = (PacingMode)((framePacer.mode() + 1) % NUM_PACING_MODES);
+		framePacer.setMode(next, framePacer.targetFps());
+		glfwSwapInterval(framePacer.swapInterval());
+		gameLog.log(LOG_INFO, LOG_FRAME, "modo de frame pacing: {}", FramePacer::modeName(next));
+	}
+	if (key == GLFW_KEY_F3 && action == GLFW_PRESS) { showHud = !showHud; }
+	if (key == GLFW_KEY_F4 && action == GLFW_PRESS) { dumpMemoryStats(stdout); }
+	if (key == GLFW_KEY_F5 && action == GLFW_PRESS) {
+		if (telemetry.recording()) {
+			telemetry.stop();
+			gameLog.log(LOG_INFO, LOG_FRAME, "telemetria: {} registros em telemetry.bin, {} descartados", telemetry.recordCount(), telemetry.droppedCount());
 		}
-	)";
-
-	// Cdigo do shader de fragmentos (Fragment Shader)
-	const GLchar* fragmentShaderSource = R"(
-		#version 400
-		in vec2 textureCoord;			 // includo
-		uniform sampler2D textureBuffer; // includo
-		uniform vec2 offsetTexture;		 // includo
-		out vec4 color;
-		void main() { color = texture(textureBuffer,textureCoord + offsetTexture); }	// modificado
-	)";
-
-	// Vertex shader
-	GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-	glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-	glCompileShader(vertexShader);
-
-	// Checando erros de compilao (exibio via log no terminal)
-	GLint success;
-	GLchar infoLog[512];
-	glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-	if (!success) {
-		glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
+		else if (telemetry.start("telemetry.bin")) { gameLog.log(LOG_INFO, LOG_FRAME, "gravando telemetria em telemetry.bin"); }
+		else { gameLog.log(LOG_ERROR, LOG_FRAME, "falha ao abrir telemetry.bin"); }
 	}
-	// Fragment shader
-	GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-	glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-	glCompileShader(fragmentShader);
-
-	// Checando erros de compilao (exibio via log no terminal)
-	glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-	if (!success) {
-		glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
+#ifdef PROFILER_ENABLED
+	// Grava as zonas de CPU e GPU que esto nos anis (abrir em chrome://tracing)
+	if (key == GLFW_KEY_F9 && action == GLFW_PRESS) {
+		if (profiler.writeChromeTrace("frame_trace.json")) { gameLog.log(LOG_INFO, LOG_FRAME, "trace gravado em frame_trace.json"); }
+		else { gameLog.log(LOG_ERROR, LOG_FRAME, "falha ao gravar frame_trace.json"); }
 	}
+#endif
+	// O estado das teclas pertence  simulao; aqui s carimbamos e repassamos o evento
+	if (action == GLFW_PRESS || action == GLFW_RELEASE) {
+		inputQueue.push(key, action);
+	}
+}
 
-	// Linkando os shaders e criando o identificador do programa de shader
-	GLuint shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-	glLinkProgram(shaderProgram);
-
-	// Checando por erros de linkagem
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &success);
-	if (!success) {
-		glGetProgramInfoLog(shaderProgram, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+
+void simulationLoop(Sprite character) {
+	/* Lgica do jogo em ticks fixos. Nada aqui chama OpenGL: o resultado de cada tick sai num snapshot. */
+
+	// Os sistemas dos itens rodam nos workers; esta thread  a thread 0 do sistema de jobs
+	JobSystem jobs(std::max(2u, std::thread::hardware_concurrency()));
+
+	// O estado do rand()  por thread no CRT do Visual Studio: a simulao tem o prprio gerador
+	simRandom.seed((unsigned)time(0));
+
+	int score = 0;
+	gameLog.log(LOG_INFO, LOG_GAMEPLAY, "Score: {}", score);/*Exibe a pontuao atual do jogador no terminal aps coletar um item.*/
+	gameLog.log(LOG_INFO, LOG_GAMEPLAY, "Vidas: {}", lives);/*Atualiza o nmero de vidas do jogador ao colidir com itens prejudiciais. Quando as vidas chegam a 0, o jogo termina.*/
+
+	// Os itens nascem pelos scripts de spawn, resumidos uma vez por tick
+	ScriptScheduler spawnScripts;
+	spawnScripts.spawn(rainScript(rainItems));
+	spawnScripts.spawn(waveScript(&character));
+	spawnScripts.spawn(bonusScript());
+
+	const chrono::nanoseconds tick(1000000000 / simTicksPerSecond);
+	chrono::steady_clock::time_point nextTick = chrono::steady_clock::now();
+
+	PROFILE_THREAD("simulacao");
+	while (simRunning.load()) {
+		chrono::steady_clock::time_point tickStart = chrono::steady_clock::now();
+
+		{
+			PROFILE_ZONE("update");
+
+			// Entrada: aplica os eventos que aconteceram at o instante deste tick; os posteriores ficam para o prximo
+			int64_t tickEnd = chrono::duration_cast<chrono::nanoseconds>(nextTick.time_since_epoch()).count();
+			keyboard.advance(inputQueue, tickEnd - tick.count(), tickEnd);
+
+			moveSprite(character);
+			animateSprite(character);
+		}
+
+		// Atualiza as hitboxes e verifica colises
+		calculateAABB(character);
+		{
+			PROFILE_ZONE("wait items");
+			jobs.wait(itemGridReady); // passo dos itens agendado no fim do tick anterior
+		}
+		uint32_t hits[maxItems];
+		float hitTimes[maxItems];
+		uint32_t nHits;
+		{
+			PROFILE_ZONE("collide");
+			nHits = checkCollisions(character, itemStore, hits, hitTimes);
+		}
+
+		{
+			PROFILE_ZONE("effects");
+
+			// Os efeitos seguem a ordem dos contatos dentro do tick
+			uint32_t order[maxItems];
+			for (uint32_t h = 0; h < nHits; h++) { order[h] = h; }
+			sort(order, order + nHits, [&](uint32_t a, uint32_t b) { return hitTimes[a] < hitTimes[b]; });
+			for (uint32_t h = 0; h < nHits && lives > 0; h++) {
+				// Atualiza pontuao ou vidas com base no tipo de item
+				int effect = itemPrototypes[itemStore.renderID[hits[order[h]]]].effect;
+				if (effect == COLLECT) {
+					score++;
+					gameLog.log(LOG_INFO, LOG_GAMEPLAY, "Score: {}", score);
+					telemetry.recordEvent(TELEMETRY_SCORE, score);
+					fruitCollected.signal();
+				} else if (effect == DENY) {
+					lives--;
+					gameLog.log(LOG_INFO, LOG_GAMEPLAY, "Vidas: {}", lives);
+					telemetry.recordEvent(TELEMETRY_LIVES, lives);
+				}
+			}
+
+			// Saem os itens pegos e os que chegaram ao cho; quem repe so os scripts
+			bool removed[maxItems] = {};
+			for (uint32_t h = 0; h < nHits; h++) { removed[hits[h]] = true; }
+			for (uint32_t i = 0; i < itemStore.size(); i++) {
+				if (itemStore.posY[i] <= 50) { removed[i] = true; }
+			}
+			// Do maior ndice para o menor: o despawn move o ltimo item para o buraco e no mexe nos ndices menores
+			for (uint32_t i = itemStore.size(); i-- > 0; ) {
+				if (removed[i]) { destroyItem(itemStore.handleAt(i)); }
+			}
+		}
+
+		{
+			PROFILE_ZONE("spawn scripts");
+			spawnScripts.tick();
+		}
+
+		{
+			PROFILE_ZONE("snapshot");
+
+			// Monta e publica o snapshot do tick
+			FrameSnapshot& frame = snapshots.writeBuffer();
+			frame.count = 0;
+			addInstance(frame, character, character.pos);
+			for (uint32_t i = 0; i < itemStore.size(); i++) {
+				addInstance(frame, itemPrototypes[itemStore.renderID[i]], math_vec4(itemStore.posX[i], itemStore.posY[i], 0.0f, 1.0f));
+			}
+			frame.gameover = lives <= 0;
+			frame.inputTime = keyboard.oldestEvent();
+			frame.entities = itemStore.size() + 1;
+			frame.scroll = character.pos.x - WIDTH / 2.0f;
+			frame.simMs = (float)chrono::duration<double, milli>(chrono::steady_clock::now() - tickStart).count();
+			snapshots.publish();
+		}
+
+		if (lives <= 0) {
+			gameLog.log(LOG_INFO, LOG_RESULT, "GAME OVER! Score final: {}", score);/*Implementa a lgica de "Game Over" quando as vidas do jogador chegam a zero.*/
+			telemetry.recordEvent(TELEMETRY_GAMEOVER, score);
+			break;
+		}
+
+		// O passo seguinte dos itens roda nos workers enquanto esta thread espera o prximo tick
+		kickItemSystems(jobs);
+
+		nextTick += tick;
+		chrono::steady_clock::time_point now = chrono::steady_clock::now();
+		if (now - nextTick > 4 * tick) { nextTick = now; } // muito atrasada (ex.: depurador): no tenta recuperar os ticks perdidos
+		this_thread::sleep_until(nextTick);
 	}
 
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
-	return shaderProgram;
+	jobs.wait(itemGridReady);
 }
 
 Sprite initializeSprite(GLuint textureID, vec3 dimensions, vec3 position, int effect, int nAnimations, int nFrames, float vel, float angle)
 {
 	Sprite sprite;
 	sprite.textureID = textureID;/*Associa texturas carregadas aos sprites do jogo, permitindo o uso de imagens para representar os personagens, itens e o fundo.*/
-	sprite.dimensions.x = dimensions.x / nFrames;
-	sprite.dimensions.y = dimensions.y / nAnimations;
-	sprite.pos = position;
+	sprite.layer = LAYER_CHARACTER;
+	sprite.dimensions = math_vec4(dimensions.x / nFrames, dimensions.y / nAnimations, dimensions.z, 0.0f);
+	sprite.pos = math_vec4(position, 1.0f);
 	sprite.effect = effect;
 	sprite.nAnimations = nAnimations;
 	sprite.nFrames = nFrames;
@@ -349,74 +560,37 @@ Sprite initializeSprite(GLuint textureID, vec3 dimensions, vec3 position, int ef
 	sprite.ds = 1.0 / (float)nFrames;
 	sprite.dt = 1.0 / (float)nAnimations;
 
-	GLfloat vertices[] = {
-		-0.5,  0.5, 0.0,    0.0,    sprite.dt,
-		-0.5, -0.5, 0.0,    0.0,       0.0,
-		 0.5,  0.5, 0.0, sprite.ds, sprite.dt,
-
-		 -0.5, -0.5, 0.0,    0.0,       0.0,
-		  0.5,  0.5, 0.0, sprite.ds, sprite.dt,
-		  0.5, -0.5, 0.0, sprite.ds,    0.0
-	};
-
-	GLuint VBO, VAO;
-	// Gerao do identificador do VBO
-	glGenBuffers(1, &VBO);/*Criao e configurao do VBO para armazenar os vrtices dos objetos do jogo.*/
-	// Faz a conexo (vincula) do buffer como um buffer de array
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	// Envia os dados do array de floats para o buffer da OpenGl
-	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-	// Gerao do identificador do VAO (Vertex Array Object)
-	glGenVertexArrays(1, &VAO);
-	// Vincula (bind) o VAO primeiro, e em seguida  conecta e seta o(s) buffer(s) de vrtices
-	// e os ponteiros para os atributos
-	glBindVertexArray(VAO);
-	// Para cada atributo do vertice, criamos um "AttribPointer" (ponteiro para o atributo)
-
-	//Atributo posio - coord x, y, z - 3 valores
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)0);
-	glEnableVertexAttribArray(0);
-
-	//Atributo coordenada de textura - coord s, t - 2 valores
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-	glEnableVertexAttribArray(1);
-
-	// Observe que isso  permitido, a chamada para glVertexAttribPointer registrou o VBO como o objeto de buffer de vrtice
-	// atualmente vinculado - para que depois possamos desvincular com segurana
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-	// Desvincula o VAO ( uma boa prtica desvincular qualquer buffer ou array para evitar bugs medonhos)
-	glBindVertexArray(0);
-
-	sprite.VAO = VAO;
-
 	return sprite;
 }
 
-void drawSprite(GLuint shaderID, Sprite& sprite)
+void addInstance(FrameSnapshot& frame, const Sprite& sprite, math_vec4 pos)
+{
+	/* Copia para o snapshot o que  preciso para desenhar o sprite, incluindo o quadro atual da spritesheet. */
+
+	InstanceSprite& instance = frame.sprites[frame.count++];
+	instance.x = pos.x;
+	instance.y = pos.y;
+	instance.width = sprite.dimensions.x;
+	instance.height = sprite.dimensions.y;
+	instance.angle = radians(sprite.angle);
+	instance.u0 = sprite.iFrame * sprite.ds; // Deslocamento horizontal
+	instance.v0 = sprite.iAnimation * sprite.dt; // Deslocamento vertical
+	instance.du = sprite.ds;
+	instance.dv = sprite.dt;
+	instance.tint = 0xFFFFFFFF;
+	instance.layer = sprite.layer;
+	frame.layerTextures[sprite.layer] = sprite.textureID;
+}
+
+void drawFrame(JobSystem& jobs, const FrameSnapshot& frame)
 {
-	glBindVertexArray(sprite.VAO); // Conectando ao buffer de geometria
-	glBindTexture(GL_TEXTURE_2D, sprite.textureID); //conectando com o buffer de textura que ser usado no draw
-
-	// Matriz de modelo: transformaes na geometria (objeto)
-	mat4 model = mat4(1); // matriz identidade
-	// Translao
-	model = translate(model, sprite.pos);
-	// Rotao
-	model = rotate(model, radians(sprite.angle), vec3(0.0, 0.0, 1.0));
-	// Escala
-	model = scale(model, sprite.dimensions);
-
-	glUniformMatrix4fv(glGetUniformLocation(shaderID, "model"), 1, GL_FALSE, value_ptr(model));
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0); // Desconectando ao buffer de geometria
-	glBindTexture(GL_TEXTURE_2D, 0); // Desconectando com o buffer de textura 
+	parallaxBackground.draw(0.0f, WIDTH, frame.scroll, (float)glfwGetTime());
+	spriteRenderer.draw(jobs, frame.sprites, frame.count, frame.layerTextures);
 }
 
 
 
-void updateSprite(GLuint shaderID, Sprite& sprite) {
+void animateSprite(Sprite& sprite) {
 	/* Atualiza a animao do sprite com base no tempo decorrido desde o ltimo quadro. */
 
 	// Incrementando o ndice do frame apenas quando fechar a taxa de FPS desejada
@@ -430,14 +604,6 @@ void updateSprite(GLuint shaderID, Sprite& sprite) {
 		sprite.iFrame = (sprite.iFrame + 1) % sprite.nFrames;//incrementando ciclicamente o indice do Frame
 		lastTime = now; // Atualiza o tempo do ltimo quadro
 	}
-
-	// Calcula o deslocamento na textura para exibir o quadro atual da animao
-	vec2 offsetTexture;
-	offsetTexture.s = sprite.iFrame * sprite.ds; // Deslocamento horizontal
-	offsetTexture.t = sprite.iAnimation * sprite.dt; // Deslocamento vertical
-
-	// Envia o deslocamento para o shader
-	glUniform2f(glGetUniformLocation(shaderID, "offsetTexture"), offsetTexture.s, offsetTexture.t); // enviando cor para varivel uniform offsetTex
 }
 
 
@@ -489,29 +655,132 @@ int loadTexture(string filePath, int& width, int& height) {
 }
 
 
-void moveSprite(GLuint shaderID, Sprite& sprite) {
+void moveSprite(Sprite& sprite) {
 	/* Gerencia o movimento horizontal do sprite com base nas teclas pressionadas. */
 
+	// Frao do tick com cada direo pressionada: um toque mais curto que o tick ainda move um pouco
+	float left = std::max(keyboard.heldFraction(GLFW_KEY_A), keyboard.heldFraction(GLFW_KEY_LEFT));
+	float right = std::max(keyboard.heldFraction(GLFW_KEY_D), keyboard.heldFraction(GLFW_KEY_RIGHT));
+
 	// Movimento para a esquerda
-	if (keys[GLFW_KEY_A] || keys[GLFW_KEY_LEFT]) {
-		sprite.pos.x -= sprite.vel; // Diminui a posio X
+	if (left > 0.0f) {
+		sprite.pos.x -= sprite.vel * left; // Diminui a posio X
 		sprite.iAnimation = MOVING_LEFT; // Define a animao para movimento  esquerda
 	}
 
 	// Movimento para a direita
-	if (keys[GLFW_KEY_D] || keys[GLFW_KEY_RIGHT]) {
-		sprite.pos.x += sprite.vel; // Aumenta a posio X
+	if (right > 0.0f) {
+		sprite.pos.x += sprite.vel * right; // Aumenta a posio X
 		sprite.iAnimation = MOVING_RIGHT; // Define a animao para movimento  direita
 	}
 
 	// Sem movimento
-	if (!keys[GLFW_KEY_A] && !keys[GLFW_KEY_D] && !keys[GLFW_KEY_LEFT] && !keys[GLFW_KEY_RIGHT]) {
+	if (left == 0.0f && right == 0.0f) {
 		sprite.iAnimation = IDLE; // Define a animao para inatividade
 	}
 }
 
 
-void spawnItem(Sprite& sprite) {
+EntityHandle createItem(int prototype) {
+	/* Retira um slot do SpriteStore e inicializa o item no fim das colunas. */
+
+	EntityHandle handle = itemStore.spawn();
+	if (handle == INVALID_ENTITY) { return handle; }
+
+	uint32_t i = itemStore.denseIndex(handle);
+	itemStore.renderID[i] = prototype;
+	itemStore.halfW[i] = itemPrototypes[prototype].dimensions.x / 2.0;
+	itemStore.halfH[i] = itemPrototypes[prototype].dimensions.y / 2.0;
+	spawnItem(i);
+	buildAABBs(itemStore, i, i + 1);
+	return handle;
+}
+
+
+void destroyItem(EntityHandle handle) {
+	/* Devolve o slot ao SpriteStore, mantendo as colunas compactas. */
+
+	itemStore.despawn(handle);
+}
+
+
+void placeItem(EntityHandle handle, float x, float vel) {
+	/* Sobrescreve a posio e a velocidade sorteadas por spawnItem. */
+
+	uint32_t i = itemStore.denseIndex(handle);
+	itemStore.posX[i] = std::min(790.0f, std::max(10.0f, x));
+	itemStore.posY[i] = 600;
+	itemStore.velX[i] = 0.0;
+	itemStore.velY[i] = -vel;
+	buildAABBs(itemStore, i, i + 1);
+}
+
+
+Script rainScript(uint32_t count) {
+	/* Mantm a chuva de itens aleatrios. */
+
+	// Handles dos itens da chuva; os que a simulao destruiu deixam de estar vivos
+	std::vector<EntityHandle> rain;
+	rain.reserve(count);
+	for (;;) {
+		rain.erase(std::remove_if(rain.begin(), rain.end(), [](EntityHandle handle) { return !itemStore.isAlive(handle); }), rain.end());
+		while (rain.size() < count) {
+			EntityHandle handle = createItem(randomInt(0, NUM_ITEM_TYPES - 1));
+			if (handle == INVALID_ENTITY) { break; } // store cheio: tenta de novo no prximo tick
+			rain.push_back(handle);
+		}
+		co_await waitNextTick();
+	}
+}
+
+
+Script waveScript(const Sprite* character) {
+	/* Ondas cronometradas: fileira de frutas e depois os cubos de gelo mirados no personagem. */
+
+	for (int wave = 1; ; wave++) {
+		co_await waitTicks(15 * simTicksPerSecond);
+		gameLog.log(LOG_INFO, LOG_GAMEPLAY, "Onda {}", wave);
+		telemetry.recordEvent(TELEMETRY_WAVE, wave);
+
+		// Fileira de frutas, uma a cada 6 ticks
+		for (int k = 0; k < 8; k++) {
+			EntityHandle handle = createItem(FRUIT);
+			if (handle != INVALID_ENTITY) { placeItem(handle, 60.0f + k * 97.0f, velItems); }
+			co_await waitTicks(6);
+		}
+
+		// Cubos de gelo mirando a posio do personagem no instante do spawn
+		co_await waitTicks(simTicksPerSecond);
+		for (int k = 0; k < std::min(wave, 5); k++) {
+			EntityHandle handle = createItem(ICECUBE);
+			if (handle != INVALID_ENTITY) { placeItem(handle, character->pos.x, velItems * 1.5f); }
+			co_await waitTicks(20);
+		}
+	}
+}
+
+
+Script bonusScript() {
+	/* Conta as frutas pegas e solta a rajada de bnus. */
+
+	for (;;) {
+		for (int k = 0; k < 5; k++) {
+			co_await fruitCollected.wait();
+		}
+		for (int k = 0; k < 3; k++) {
+			EntityHandle handle = createItem(FRUIT);
+			if (handle != INVALID_ENTITY) { placeItem(handle, 100.0f + randomInt(0, 599), velItems * 0.8f); }
+		}
+	}
+}
+
+
+int randomInt(int min, int max) {
+	return std::uniform_int_distribution<int>(min, max)(simRandom);
+}
+
+
+void spawnItem(uint32_t i) {
 	/* Configura a posio inicial e a velocidade de um item de forma aleatria. */
 
 	// Define os limites de posio no eixo X
@@ -521,61 +790,96 @@ void spawnItem(Sprite& sprite) {
 	if (min < 10) min = 10;
 
 	// Gera uma posio X aleatria dentro dos limites
-	sprite.pos.x = rand() % (max - min + 1) + min;
-	lastSpawnX = sprite.pos.x; // Atualiza a ltima posio gerada
+	itemStore.posX[i] = randomInt(min, max);
+	lastSpawnX = itemStore.posX[i]; // Atualiza a ltima posio gerada
 
 	// Define a posio Y inicial
-	sprite.pos.y = 600;
+	itemStore.posY[i] = 600;
 
-	// Define a velocidade do item
-	sprite.vel = velItems;
-	int n = rand() % 3;
+	// Define a velocidade do item (negativa: o item cai)
+	float vel = velItems;
+	int n = randomInt(0, 2);
 	if (n == 1) {
-		sprite.vel += sprite.vel * 0.11; // Aumenta ligeiramente a velocidade
+		vel += vel * 0.11; // Aumenta ligeiramente a velocidade
 	}
 	else if (n == 2) {
-		sprite.vel -= sprite.vel * 0.11; // Reduz ligeiramente a velocidade
+		vel -= vel * 0.11; // Reduz ligeiramente a velocidade
 	}
+	itemStore.velX[i] = 0.0;
+	itemStore.velY[i] = -vel;
 }
 
 
-void updateItems(GLuint shader, Sprite& sprite) {
-	/* Atualiza a posio do item. Se o item sair da tela, ele  reposicionado. */
+void kickItemSystems(JobSystem& jobs) {
+	/* Monta o grafo do passo dos itens. Cada etapa s comea quando o contador da anterior zera. */
 
-	// Verifica se o item ainda est na tela
-	if (sprite.pos.y > 50) {
-		sprite.pos.y -= sprite.vel; // Move o item para baixo
-	}
-	else {
-		// Reposiciona o item caso saia da tela
-		spawnItem(sprite);
-	}
+	uint32_t n = itemStore.size();
+	jobs.run(moveItemsJob, &itemStore, 0, n, jobGrain, itemsMoved);
+	jobs.runAfter(itemsMoved, buildItemAABBsJob, &itemStore, 0, n, jobGrain, itemsBounded);
+	jobs.runAfter(itemsBounded, buildItemGridJob, &itemStore, 0, n, n, itemGridReady);
 }
 
 
-void calculateAABB(Sprite& sprite) {
-	/* Calcula a bounding box (AABB) do sprite para deteco de coliso. */
+void moveItemsJob(void* data, uint32_t first, uint32_t last) {
+	/* Move os itens para baixo, percorrendo s as colunas de posio e velocidade. */
+
+	PROFILE_ZONE("move items");
+	integrateMotion(*(SpriteStore*)data, first, last);
+}
 
-	// Coordenadas mnimas da bounding box
-	sprite.PMin.x = sprite.pos.x - sprite.dimensions.x / 2.0;
-	sprite.PMin.y = sprite.pos.y - sprite.dimensions.y / 2.0;
 
-	// Coordenadas mximas da bounding box
-	sprite.PMax.x = sprite.pos.x + sprite.dimensions.x / 2.0;
-	sprite.PMax.y = sprite.pos.y + sprite.dimensions.y / 2.0;
+void buildItemAABBsJob(void* data, uint32_t first, uint32_t last) {
+	PROFILE_ZONE("item AABBs");
+	buildAABBs(*(SpriteStore*)data, first, last);
 }
 
 
-bool checkCollision(Sprite one, Sprite two) {
-	/* Verifica se h coliso entre dois sprites usando suas bounding boxes (AABB). */
+void buildItemGridJob(void* data, uint32_t first, uint32_t last) {
+	PROFILE_ZONE("item grid");
+	SpriteStore& store = *(SpriteStore*)data;
+	itemGrid.build(store.aabbColumns(), store.size());
+}
 
-	// Verifica a interseo no eixo X
-	bool collisionX = (one.PMax.x >= two.PMin.x) && (two.PMax.x >= one.PMin.x);
 
-	// Verifica a interseo no eixo Y
-	bool collisionY = (one.PMax.y >= two.PMin.y) && (two.PMax.y >= one.PMin.y);
+void calculateAABB(Sprite& sprite) {
+	/* Calcula a bounding box (AABB) do sprite para deteco de coliso. */
 
-	// Retorna verdadeiro se houver coliso em ambos os eixos
-	return collisionX && collisionY;
+	// Coordenadas mnimas e mximas da bounding box, as duas de uma vez em cada vec4
+	math_vec4 half = sprite.dimensions * 0.5f;
+	sprite.PMin = sprite.pos - half;
+	sprite.PMax = sprite.pos + half;
 }
 
+
+uint32_t checkCollisions(const Sprite& one, const SpriteStore& store, uint32_t* hits, float* hitTimes) {
+	/* Verifica quais itens encostam no sprite durante o tick, usando as bounding boxes (AABB) e a velocidade dos itens. */
+
+	AABB box = { one.PMin.x, one.PMin.y, one.PMax.x, one.PMax.y };
+
+	// Alcance: o maior deslocamento de um item neste tick
+	float reach = 0.0f;
+	for (uint32_t i = 0; i < store.size(); i++) {
+		reach = std::max(reach, std::max(std::fabs(store.velX[i]), std::fabs(store.velY[i])));
+	}
+	AABB reachBox = { box.minX - reach, box.minY - reach, box.maxX + reach, box.maxY + reach };
+
+	// Broadphase: s os itens que dividem uma clula da grade com a caixa de alcance
+	uint32_t candidates[maxItems];
+	uint32_t nCandidates = itemGrid.query(reachBox, candidates);
+	sort(candidates, candidates + nCandidates);
+
+	// Narrowphase: o segmento percorrido por cada candidato no tick contra o sprite (o personagem  tratado como parado)
+	float posX[maxItems], posY[maxItems], halfW[maxItems], halfH[maxItems], velX[maxItems], velY[maxItems];
+	for (uint32_t c = 0; c < nCandidates; c++) {
+		uint32_t i = candidates[c];
+		posX[c] = store.posX[i]; posY[c] = store.posY[i];
+		halfW[c] = store.halfW[i]; halfH[c] = store.halfH[i];
+		velX[c] = store.velX[i]; velY[c] = store.velY[i];
+	}
+	SweptBatch batch = { posX, posY, halfW, halfH, velX, velY };
+	uint32_t nHits = sweepAgainstBox(box, 0.0f, 0.0f, batch, nCandidates, hits, hitTimes);
+	for (uint32_t h = 0; h < nHits; h++) {
+		hits[h] = candidates[hits[h]];
+	}
+	return nHits;
+}